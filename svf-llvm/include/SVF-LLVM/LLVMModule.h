@@ -70,6 +70,8 @@ private:
     std::unique_ptr<LLVMContext> cxts;
     std::vector<std::unique_ptr<Module>> owned_modules;
     std::vector<std::reference_wrapper<Module>> modules;
+    /// Modules pre-processed while they were loaded
+    Set<const Module*> preProcessedModules;
 
     /// Function declaration to function definition map
     FunDeclToDefMapTy FunDeclToDefMap;
@@ -356,6 +358,7 @@ private:
     std::vector<const Function*> getLLVMGlobalFunctions(const GlobalVariable* global);
 
     void loadModules(const std::vector<std::string>& moduleNameVec);
+    void loadModulesInParallel(const std::vector<std::string>& moduleNameVec);
     void loadExtAPIModules();
     void addSVFMain();
 
@@ -369,6 +372,7 @@ private:
     void buildGlobalDefToRepMap();
     /// Invoke llvm passes to modify module
     void prePassSchedule();
+    static void prePassSchedule(Module& mod);
     void buildSymbolTable() const;
 };
 
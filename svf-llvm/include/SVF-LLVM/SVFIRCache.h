@@ -0,0 +1,60 @@
+//===- SVFIRCache.h -- On-disk cache of built SVFIRs ---------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * SVFIRCache.h
+ *
+ * With -svfir-cache=DIR, the SVFIR (including its ICFG, CHG and symbol table)
+ * built from a set of bitcode files is written to DIR as JSON, in a file named
+ * after a hash of the contents of the bitcode files and extapi.bc and of the
+ * options affecting SVFIR construction. Later runs on unchanged inputs read the
+ * SVFIR back instead of loading the LLVM modules and building it again.
+ */
+
+#ifndef INCLUDE_SVF_LLVM_SVFIRCACHE_H_
+#define INCLUDE_SVF_LLVM_SVFIRCACHE_H_
+
+#include "SVFIR/SVFIR.h"
+
+namespace SVF
+{
+
+class SVFIRCache
+{
+public:
+    /// Build the SVFIR of the modules, or read it from the cache if it is there.
+    /// On a cache hit, no LLVM module is loaded.
+    static SVFIR* build(const std::vector<std::string>& moduleNameVec);
+
+    /// Path of the cached SVFIR of the modules, empty if caching is disabled
+    /// or not applicable (e.g., the modules are to be annotated)
+    static std::string getCachePath(const std::vector<std::string>& moduleNameVec);
+
+private:
+    /// Hash of the inputs and options which the built SVFIR depends on,
+    /// false if an input cannot be read
+    static bool computeKey(const std::vector<std::string>& moduleNameVec, u64_t& key);
+};
+
+} // End namespace SVF
+
+#endif /* INCLUDE_SVF_LLVM_SVFIRCACHE_H_ */
@@ -29,6 +29,8 @@
 
 #include <queue>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 #include "SVFIR/SVFModule.h"
 #include "Util/SVFUtil.h"
 #include "SVF-LLVM/BasicTypes.h"
@@ -36,6 +38,7 @@
 #include "SVF-LLVM/BreakConstantExpr.h"
 #include "SVF-LLVM/SymbolTableBuilder.h"
 #include "MSSA/SVFGBuilder.h"
+#include "Util/PhaseStat.h"
 #include "llvm/Support/FileSystem.h"
 
 using namespace std;
@@ -82,10 +85,13 @@ SVFModule* LLVMModuleSet::buildSVFModule(Module &mod)
     LLVMModuleSet* mset = getLLVMModuleSet();
 
     double startSVFModuleTime = SVFStat::getClk(true);
-    SVFModule::getSVFModule()->setModuleIdentifier(mod.getModuleIdentifier());
-    mset->modules.emplace_back(mod);
+    {
+        PhaseStat::Scope phase("LLVMModule");
+        SVFModule::getSVFModule()->setModuleIdentifier(mod.getModuleIdentifier());
+        mset->modules.emplace_back(mod);
 
-    mset->build();
+        mset->build();
+    }
     double endSVFModuleTime = SVFStat::getClk(true);
     SVFStat::timeOfBuildingLLVMModule = (endSVFModuleTime - startSVFModuleTime)/TIMEINTERVAL;
 
@@ -100,15 +106,18 @@ SVFModule* LLVMModuleSet::buildSVFModule(const std::vector<std::string> &moduleN
 
     LLVMModuleSet* mset = getLLVMModuleSet();
 
-    mset->loadModules(moduleNameVec);
-    mset->loadExtAPIModules();
-
-    if (!moduleNameVec.empty())
     {
-        SVFModule::getSVFModule()->setModuleIdentifier(moduleNameVec.front());
-    }
+        PhaseStat::Scope phase("LLVMModule");
+        mset->loadModules(moduleNameVec);
+        mset->loadExtAPIModules();
 
-    mset->build();
+        if (!moduleNameVec.empty())
+        {
+            SVFModule::getSVFModule()->setModuleIdentifier(moduleNameVec.front());
+        }
+
+        mset->build();
+    }
 
     double endSVFModuleTime = SVFStat::getClk(true);
     SVFStat::timeOfBuildingLLVMModule =
@@ -121,6 +130,7 @@ SVFModule* LLVMModuleSet::buildSVFModule(const std::vector<std::string> &moduleN
 
 void LLVMModuleSet::buildSymbolTable() const
 {
+    PhaseStat::Scope phase("SymbolTable");
     double startSymInfoTime = SVFStat::getClk(true);
     if (!SVFModule::pagReadFromTXT())
     {
@@ -430,25 +440,31 @@ void LLVMModuleSet::initDomTree(SVFFunction* svffun, const Function* fun)
  */
 void LLVMModuleSet::prePassSchedule()
 {
-    /// BreakConstantGEPs Pass
-    std::unique_ptr<BreakConstantGEPs> p1 = std::make_unique<BreakConstantGEPs>();
     for (Module &M : getLLVMModules())
     {
-        p1->runOnModule(M);
+        if (!preProcessedModules.count(&M))
+            prePassSchedule(M);
     }
+}
+
+/*!
+ * Invoke llvm passes to modify one module, which only touches the module and its context
+ */
+void LLVMModuleSet::prePassSchedule(Module& M)
+{
+    /// BreakConstantGEPs Pass
+    std::unique_ptr<BreakConstantGEPs> p1 = std::make_unique<BreakConstantGEPs>();
+    p1->runOnModule(M);
 
     /// MergeFunctionRets Pass
     std::unique_ptr<UnifyFunctionExitNodes> p2 =
         std::make_unique<UnifyFunctionExitNodes>();
-    for (Module &M : getLLVMModules())
+    for (auto F = M.begin(), E = M.end(); F != E; ++F)
     {
-        for (auto F = M.begin(), E = M.end(); F != E; ++F)
-        {
-            Function &fun = *F;
-            if (fun.isDeclaration())
-                continue;
-            p2->runOnFunction(fun);
-        }
+        Function &fun = *F;
+        if (fun.isDeclaration())
+            continue;
+        p2->runOnFunction(fun);
     }
 }
 
@@ -514,7 +530,16 @@ void LLVMModuleSet::loadModules(const std::vector<std::string> &moduleNameVec)
             SVFUtil::errs() << "not an IR file: " << moduleName << std::endl;
             abort();
         }
+    }
+
+    if (Options::LoadThreads() > 1 && moduleNameVec.size() > 1)
+    {
+        loadModulesInParallel(moduleNameVec);
+        return;
+    }
 
+    for (const std::string& moduleName : moduleNameVec)
+    {
         SMDiagnostic Err;
         std::unique_ptr<Module> mod = parseIRFile(moduleName, Err, *cxts);
         if (mod == nullptr)
@@ -528,6 +553,60 @@ void LLVMModuleSet::loadModules(const std::vector<std::string> &moduleNameVec)
     }
 }
 
+/*!
+ * An LLVMContext cannot be shared by threads, so each module is parsed and pre-processed
+ * (prePassSchedule) in a context of its own on Options::LoadThreads() threads, and
+ * handed over as bitcode. The bitcode is then read into the shared context in the order
+ * of moduleNameVec, so the modules are the same as if they were loaded one by one.
+ */
+void LLVMModuleSet::loadModulesInParallel(const std::vector<std::string> &moduleNameVec)
+{
+    std::vector<llvm::SmallVector<char, 0>> bitcodes(moduleNameVec.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&moduleNameVec, &bitcodes, &next]()
+    {
+        for (size_t i = next++; i < moduleNameVec.size(); i = next++)
+        {
+            LLVMContext cxt;
+            SMDiagnostic Err;
+            std::unique_ptr<Module> mod = parseIRFile(moduleNameVec[i], Err, cxt);
+            if (mod == nullptr)
+            {
+                SVFUtil::errs() << "load module: " << moduleNameVec[i] << "failed!!\n\n";
+                Err.print("SVFModuleLoader", llvm::errs());
+                abort();
+            }
+            prePassSchedule(*mod);
+            llvm::raw_svector_ostream OS(bitcodes[i]);
+            // Use lists are kept so that users are visited in the same order as in the serial build
+            WriteBitcodeToFile(*mod, OS, /*ShouldPreserveUseListOrder=*/true);
+        }
+    };
+    std::vector<std::thread> workers;
+    u32_t numThreads = std::min<size_t>(Options::LoadThreads(), moduleNameVec.size());
+    for (u32_t t = 1; t < numThreads; ++t)
+        workers.push_back(std::thread(worker));
+    worker();
+    for (std::thread& w : workers)
+        w.join();
+
+    for (size_t i = 0; i < moduleNameVec.size(); ++i)
+    {
+        llvm::MemoryBufferRef buffer(llvm::StringRef(bitcodes[i].data(), bitcodes[i].size()), moduleNameVec[i]);
+        llvm::Expected<std::unique_ptr<Module>> mod = parseBitcodeFile(buffer, *cxts);
+        if (!mod)
+        {
+            SVFUtil::errs() << "load module: " << moduleNameVec[i] << "failed!!\n\n";
+            llvm::logAllUnhandledErrors(mod.takeError(), llvm::errs(), "SVFModuleLoader: ");
+            abort();
+        }
+        llvm::SmallVector<char, 0>().swap(bitcodes[i]);
+        preProcessedModules.insert(mod->get());
+        modules.emplace_back(**mod);
+        owned_modules.emplace_back(std::move(*mod));
+    }
+}
+
 void LLVMModuleSet::loadExtAPIModules()
 {
     // Load external API module (extapi.bc)
@@ -40,6 +40,7 @@
 #include "SVF-LLVM/CHGBuilder.h"
 #include "SVFIR/SVFFileSystem.h"
 #include "SVF-LLVM/SymbolTableBuilder.h"
+#include "Util/PhaseStat.h"
 
 
 using namespace std;
@@ -53,6 +54,7 @@ using namespace LLVMUtil;
  */
 SVFIR* SVFIRBuilder::build()
 {
+    PhaseStat::Scope phase("SVFIR");
     double startTime = SVFStat::getClk(true);
 
     DBOUT(DGENERAL, outs() << pasMsg("\t Building SVFIR ...\n"));
@@ -61,10 +63,13 @@ SVFIR* SVFIRBuilder::build()
     pag->setModule(svfModule);
 
     // Build ICFG
-    ICFG* icfg = new ICFG();
-    ICFGBuilder icfgbuilder(icfg);
-    icfgbuilder.build(svfModule);
-    pag->setICFG(icfg);
+    {
+        PhaseStat::Scope icfgPhase("ICFG");
+        ICFG* icfg = new ICFG();
+        ICFGBuilder icfgbuilder(icfg);
+        icfgbuilder.build(svfModule);
+        pag->setICFG(icfg);
+    }
 
     CHGraph* chg = new CHGraph(pag->getModule());
     CHGBuilder chgbuilder(chg);
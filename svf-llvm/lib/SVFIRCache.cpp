@@ -0,0 +1,116 @@
+//===- SVFIRCache.cpp -- On-disk cache of built SVFIRs -------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * SVFIRCache.cpp
+ */
+
+#include "SVF-LLVM/SVFIRCache.h"
+#include "SVF-LLVM/SVFIRBuilder.h"
+#include "SVFIR/SVFFileSystem.h"
+#include "Util/ExtAPI.h"
+#include "Util/Options.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/xxhash.h"
+#include <sstream>
+
+using namespace SVF;
+using namespace SVFUtil;
+
+/// Bump whenever the SVFIR builder or the JSON format changes, so that stale caches are ignored
+static const char* const cacheFormat = "svfir-cache-1";
+
+bool SVFIRCache::computeKey(const std::vector<std::string>& moduleNameVec, u64_t& key)
+{
+    std::stringstream keyStr;
+    keyStr << cacheFormat << "\n";
+
+    std::vector<std::string> inputs(moduleNameVec);
+    inputs.push_back(ExtAPI::getExtAPI()->getExtBcPath());
+    for (const std::string& input : inputs)
+    {
+        llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buf = llvm::MemoryBuffer::getFile(input);
+        if (!buf)
+            return false;
+        llvm::StringRef content = (*buf)->getBuffer();
+        keyStr << content.size() << ":" << llvm::xxHash64(content) << "\n";
+    }
+
+    keyStr << Options::MaxFieldLimit() << Options::ModelConsts() << Options::ModelArrays()
+           << Options::SVFMain() << Options::VtableInSVFIR() << Options::LoopAnalysis()
+           << ":" << Options::LoopBound();
+
+    key = llvm::xxHash64(keyStr.str());
+    return true;
+}
+
+std::string SVFIRCache::getCachePath(const std::vector<std::string>& moduleNameVec)
+{
+    // Annotating modules and reading the SVFIR from a text file both need the original inputs
+    if (Options::SVFIRCacheDir().empty() || Options::WriteAnder() == "ir_annotator" || !Options::Graphtxt().empty())
+        return "";
+
+    u64_t key;
+    if (!computeKey(moduleNameVec, key))
+        return "";
+
+    std::stringstream name;
+    name << std::hex << key << ".svfir.json";
+    llvm::SmallString<256> path(Options::SVFIRCacheDir());
+    llvm::sys::path::append(path, name.str());
+    return path.str().str();
+}
+
+SVFIR* SVFIRCache::build(const std::vector<std::string>& moduleNameVec)
+{
+    std::string path = getCachePath(moduleNameVec);
+    if (!path.empty() && llvm::sys::fs::exists(path))
+    {
+        DBOUT(DGENERAL, outs() << pasMsg("\t Reading cached SVFIR " + path + "\n"));
+        return SVFIRReader::read(path);
+    }
+
+    SVFModule* svfModule = LLVMModuleSet::buildSVFModule(moduleNameVec);
+    SVFIRBuilder builder(svfModule);
+    SVFIR* pag = builder.build();
+
+    if (!path.empty())
+    {
+        // Write to a temporary file first so that concurrent runs never read a partial cache file
+        if (std::error_code err = llvm::sys::fs::create_directories(Options::SVFIRCacheDir()))
+        {
+            writeWrnMsg("cannot create SVFIR cache directory " + Options::SVFIRCacheDir() + ": " + err.message());
+            return pag;
+        }
+        std::string tmpPath = path + ".tmp" + std::to_string(llvm::sys::Process::getProcessId());
+        SVFIRWriter::writeJsonToPath(pag, tmpPath);
+        if (std::error_code err = llvm::sys::fs::rename(tmpPath, path))
+        {
+            writeWrnMsg("cannot write SVFIR cache " + path + ": " + err.message());
+            llvm::sys::fs::remove(tmpPath);
+        }
+    }
+    return pag;
+}
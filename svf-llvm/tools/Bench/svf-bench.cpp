@@ -0,0 +1,335 @@
+//===- svf-bench.cpp -- Benchmarking the analysis pipeline -------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===-----------------------------------------------------------------------===//
+
+/*
+ // Benchmarking the analysis pipeline
+ //
+ // Each input bitcode file is analysed (module loading, SVFIR, Andersen's analysis,
+ // MemSSA, SVFG, FS/VFS, SABER and MHP) several times, each run in a fresh process so that
+ // runs and inputs do not share singletons or memory peaks. The wall time, CPU time and
+ // peak RSS of every phase are reported in JSON, e.g.,
+ //
+ //   svf-bench -bench-runs=5 -bench-json=base.json a.bc b.bc
+ //
+ // The report records whether SVF was built with SVF_FLAT_HASH_MAP, so that the Map/Set
+ // implementations can be compared by running the same inputs with both builds, e.g.,
+ //
+ //   svf-bench -bench-analyses=ander,mssa,mhp -bench-json=flat.json a.bc
+ */
+
+#include "SVF-LLVM/LLVMUtil.h"
+#include "SVF-LLVM/SVFIRBuilder.h"
+#include "WPA/Andersen.h"
+#include "WPA/FlowSensitive.h"
+#include "WPA/VersionedFlowSensitive.h"
+#include "MSSA/SVFGBuilder.h"
+#include "MTA/MTA.h"
+#include "SABER/LeakChecker.h"
+#include "Util/CommandLine.h"
+#include "Util/Options.h"
+#include "Util/PhaseStat.h"
+#include "Util/cJSON.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <sstream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace llvm;
+using namespace SVF;
+
+static Option<u32_t> BenchRuns(
+    "bench-runs",
+    "Number of runs per input",
+    3
+);
+
+static Option<std::string> BenchJSON(
+    "bench-json",
+    "File the JSON report is written to (standard output if empty)",
+    ""
+);
+
+static Option<std::string> BenchAnalyses(
+    "bench-analyses",
+    "Comma separated analyses to run after the SVFIR is built (ander, mssa, fs, vfs, saber, mhp)",
+    "ander,fs,vfs,saber"
+);
+
+typedef PhaseStat::PhaseList PhaseList;
+
+/*!
+ * Run the pipeline on a single input.
+ */
+static void runPipeline(const std::string& input, const std::vector<std::string>& analyses)
+{
+    std::vector<std::string> moduleNameVec = {input};
+    SVFModule* svfModule = LLVMModuleSet::buildSVFModule(moduleNameVec);
+    SVFIRBuilder builder(svfModule);
+    SVFIR* pag = builder.build();
+
+    for (const std::string& analysis : analyses)
+    {
+        if (analysis == "ander")
+            AndersenWaveDiff::createAndersenWaveDiff(pag);
+        else if (analysis == "mssa")
+        {
+            SVFGBuilder svfgBuilder;
+            svfgBuilder.buildMSSA(AndersenWaveDiff::createAndersenWaveDiff(pag), false);
+        }
+        else if (analysis == "fs")
+            FlowSensitive::createFSWPA(pag);
+        else if (analysis == "vfs")
+            VersionedFlowSensitive::createVFSWPA(pag);
+        else if (analysis == "saber")
+        {
+            LeakChecker saber;
+            saber.runOnModule(pag);
+        }
+        else if (analysis == "mhp")
+        {
+            MTA mta;
+            mta.runOnModule(pag);
+        }
+    }
+}
+
+/*!
+ * Run the pipeline in a child process, whose output (e.g., bug reports) is discarded, and
+ * collect its phases, one per line "depth wall cpu rss name" through a pipe.
+ * Returns false if the child failed.
+ */
+static bool benchmarkRun(const std::string& input, const std::vector<std::string>& analyses, PhaseList& phases)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+        return false;
+
+    fflush(stdout);
+    fflush(stderr);
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+
+    if (pid == 0)
+    {
+        close(fds[0]);
+        int devNull = open("/dev/null", O_WRONLY);
+        if (devNull >= 0)
+        {
+            dup2(devNull, STDOUT_FILENO);
+            dup2(devNull, STDERR_FILENO);
+        }
+
+        PhaseStat::setEnabled(true);
+        PhaseStat::startPhase("Total");
+        runPipeline(input, analyses);
+        PhaseStat::endPhase();
+
+        std::ostringstream out;
+        out.precision(9);
+        for (const PhaseStat::Phase& phase : PhaseStat::getPhases())
+            out << phase.depth << " " << phase.wallTime << " " << phase.cpuTime << " "
+                << phase.peakRSS << " " << phase.name << "\n";
+        const std::string& data = out.str();
+        size_t written = 0;
+        while (written < data.size())
+        {
+            ssize_t n = write(fds[1], data.data() + written, data.size() - written);
+            if (n <= 0)
+                break;
+            written += n;
+        }
+        close(fds[1]);
+        // Skip the destructors of the analyses, they are not part of the measurements.
+        _exit(written == data.size() ? 0 : 1);
+    }
+
+    close(fds[1]);
+    std::string data;
+    char buf[4096];
+    ssize_t n;
+    while ((n = read(fds[0], buf, sizeof(buf))) > 0)
+        data.append(buf, n);
+    close(fds[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        return false;
+
+    std::istringstream in(data);
+    PhaseStat::Phase phase;
+    while (in >> phase.depth >> phase.wallTime >> phase.cpuTime >> phase.peakRSS)
+    {
+        std::getline(in >> std::ws, phase.name);
+        phases.push_back(phase);
+    }
+    return !phases.empty();
+}
+
+static double median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+}
+
+static cJSON* phaseToJson(const PhaseStat::Phase& phase)
+{
+    cJSON* obj = cJSON_CreateObject();
+    cJSON_AddStringToObject(obj, "name", phase.name.c_str());
+    cJSON_AddNumberToObject(obj, "depth", phase.depth);
+    cJSON_AddNumberToObject(obj, "wall", phase.wallTime);
+    cJSON_AddNumberToObject(obj, "cpu", phase.cpuTime);
+    cJSON_AddNumberToObject(obj, "peakRSS", phase.peakRSS);
+    return obj;
+}
+
+/*!
+ * Summarise the runs of an input phase by phase. Runs are deterministic, so the i-th
+ * phase of every run is the same phase; runs that disagree are left out of the summary.
+ */
+static cJSON* summaryToJson(const std::vector<PhaseList>& runs)
+{
+    cJSON* summary = cJSON_CreateArray();
+    if (runs.empty())
+        return summary;
+
+    const PhaseList& first = runs.front();
+    for (size_t i = 0; i < first.size(); ++i)
+    {
+        std::vector<double> wall, cpu;
+        u64_t peakRSS = 0;
+        for (const PhaseList& run : runs)
+        {
+            if (run.size() != first.size() || run[i].name != first[i].name)
+                continue;
+            wall.push_back(run[i].wallTime);
+            cpu.push_back(run[i].cpuTime);
+            peakRSS = std::max(peakRSS, run[i].peakRSS);
+        }
+
+        cJSON* obj = cJSON_CreateObject();
+        cJSON_AddStringToObject(obj, "name", first[i].name.c_str());
+        cJSON_AddNumberToObject(obj, "depth", first[i].depth);
+        cJSON_AddNumberToObject(obj, "runs", wall.size());
+        cJSON_AddNumberToObject(obj, "medianWall", median(wall));
+        cJSON_AddNumberToObject(obj, "minWall", *std::min_element(wall.begin(), wall.end()));
+        cJSON_AddNumberToObject(obj, "medianCPU", median(cpu));
+        cJSON_AddNumberToObject(obj, "maxPeakRSS", peakRSS);
+        cJSON_AddItemToArray(summary, obj);
+    }
+    return summary;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> moduleNameVec = OptionBase::parseOptions(
+                argc, argv, "Benchmarking the analysis pipeline", "[options] <input-bitcode...>");
+
+    std::vector<std::string> analyses;
+    std::istringstream analysesStream(BenchAnalyses());
+    std::string analysis;
+    while (std::getline(analysesStream, analysis, ','))
+    {
+        if (analysis.empty())
+            continue;
+        if (analysis != "ander" && analysis != "mssa" && analysis != "fs" && analysis != "vfs" &&
+                analysis != "saber" && analysis != "mhp")
+        {
+            SVFUtil::errs() << "svf-bench: unknown analysis '" << analysis << "'\n";
+            return 1;
+        }
+        analyses.push_back(analysis);
+    }
+
+    cJSON* root = cJSON_CreateObject();
+    cJSON_AddNumberToObject(root, "runs", BenchRuns());
+    cJSON_AddStringToObject(root, "analyses", BenchAnalyses().c_str());
+#ifdef SVF_FLAT_HASH_MAP
+    cJSON_AddStringToObject(root, "hashTables", "flat");
+#else
+    cJSON_AddStringToObject(root, "hashTables", "std");
+#endif
+    cJSON* inputs = cJSON_AddArrayToObject(root, "inputs");
+
+    int ret = 0;
+    for (const std::string& input : moduleNameVec)
+    {
+        std::vector<PhaseList> runs;
+        cJSON* runsJson = cJSON_CreateArray();
+        u32_t failures = 0;
+        for (u32_t i = 0; i < BenchRuns(); ++i)
+        {
+            PhaseList phases;
+            if (!benchmarkRun(input, analyses, phases))
+            {
+                SVFUtil::errs() << "svf-bench: run " << i << " on " << input << " failed\n";
+                ++failures;
+                continue;
+            }
+            cJSON* phasesJson = cJSON_CreateArray();
+            for (const PhaseStat::Phase& phase : phases)
+                cJSON_AddItemToArray(phasesJson, phaseToJson(phase));
+            cJSON_AddItemToArray(runsJson, phasesJson);
+            runs.push_back(phases);
+        }
+        if (failures)
+            ret = 1;
+
+        cJSON* inputJson = cJSON_CreateObject();
+        cJSON_AddStringToObject(inputJson, "input", input.c_str());
+        cJSON_AddNumberToObject(inputJson, "failedRuns", failures);
+        cJSON_AddItemToObject(inputJson, "summary", summaryToJson(runs));
+        cJSON_AddItemToObject(inputJson, "runs", runsJson);
+        cJSON_AddItemToArray(inputs, inputJson);
+    }
+
+    char* report = cJSON_Print(root);
+    if (BenchJSON().empty())
+    {
+        SVFUtil::outs() << report << "\n";
+    }
+    else
+    {
+        std::error_code err;
+        raw_fd_ostream out(BenchJSON(), err);
+        if (err)
+        {
+            SVFUtil::errs() << "svf-bench: cannot write " << BenchJSON() << ": " << err.message() << "\n";
+            ret = 1;
+        }
+        else
+            out << report << "\n";
+    }
+    cJSON_free(report);
+    cJSON_Delete(root);
+
+    return ret;
+}
@@ -31,7 +31,7 @@
 // then runs the analysis.
 
 #include "SVF-LLVM/LLVMUtil.h"
-#include "SVF-LLVM/SVFIRBuilder.h"
+#include "SVF-LLVM/SVFIRCache.h"
 #include "CFL/CFLAlias.h"
 #include "CFL/CFLVF.h"
 
@@ -58,9 +58,7 @@ int main(int argc, char ** argv)
     // If no CFLGraph option is specified, the SVFIR is built from the .bc (bytecode) files of the modules
     if (Options::CFLGraph().empty())
     {
-        SVFModule* svfModule = LLVMModuleSet::buildSVFModule(moduleNameVec);
-        SVFIRBuilder builder(svfModule);
-        svfir = builder.build();
+        svfir = SVFIRCache::build(moduleNameVec);
     }  // if no dot form CFLGraph is specified, we use svfir from .bc.
 
     // The CFLBase pointer that will be used to run the analysis
@@ -29,7 +29,7 @@
 //#include "AliasUtil/AliasAnalysisCounter.h"
 //#include "MemoryModel/ComTypeModel.h"
 #include "SVF-LLVM/LLVMUtil.h"
-#include "SVF-LLVM/SVFIRBuilder.h"
+#include "SVF-LLVM/SVFIRCache.h"
 #include "DDA/DDAPass.h"
 #include "Util/Options.h"
 
@@ -87,9 +87,7 @@ int main(int argc, char ** argv)
         LLVMModuleSet::preProcessBCs(moduleNameVec);
     }
 
-    SVFModule* svfModule = LLVMModuleSet::buildSVFModule(moduleNameVec);
-    SVFIRBuilder builder(svfModule);
-    SVFIR* pag = builder.build();
+    SVFIR* pag = SVFIRCache::build(moduleNameVec);
 
     DDAPass dda;
     dda.runOnModule(pag);
@@ -177,9 +177,8 @@ inline std::string MTAResultValidator::getOutputforInterlevAnalysis(const char *
 
 bool MTAResultValidator::matchCxt(const CallStrCxt cxt1, const CallStrCxt cxt2) const
 {
-    if (cxt1.size() != cxt2.size())
-        return false;
-    return std::equal(cxt1.begin(), cxt1.end(), cxt2.begin());
+    // Contexts are interned, so equal call strings are the same context.
+    return cxt1 == cxt2;
 }
 
 void MTAResultValidator::dumpCxt(const CallStrCxt& cxt) const
@@ -187,11 +186,11 @@ void MTAResultValidator::dumpCxt(const CallStrCxt& cxt) const
     std::string str;
     std::stringstream rawstr(str);
     rawstr << "[:";
-    for (CallStrCxt::const_iterator it = cxt.begin(), eit = cxt.end(); it != eit; ++it)
+    for (CallSiteID csId : cxt.toVector())
     {
-        rawstr << " ' " << *it << " ' ";
-        rawstr << tcg->getCallSite(*it)->getCallSite()->toString();
-        rawstr << "  call  " << tcg->getCallSite(*it)->getCaller()->getName() << "-->" << tcg->getCalleeOfCallSite(*it)->getName() << ", \n";
+        rawstr << " ' " << csId << " ' ";
+        rawstr << tcg->getCallSite(csId)->getCallSite()->toString();
+        rawstr << "  call  " << tcg->getCallSite(csId)->getCaller()->getName() << "-->" << tcg->getCalleeOfCallSite(csId)->getName() << ", \n";
     }
     rawstr << " ]";
     outs() << "max cxt = " << cxt.size() << rawstr.str() << "\n";
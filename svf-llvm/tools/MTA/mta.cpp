@@ -21,7 +21,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "SVF-LLVM/LLVMUtil.h"
-#include "SVF-LLVM/SVFIRBuilder.h"
+#include "SVF-LLVM/SVFIRCache.h"
 #include "MTA/MTA.h"
 #include "Util/CommandLine.h"
 #include "Util/Options.h"
@@ -44,9 +44,7 @@ int main(int argc, char ** argv)
         LLVMModuleSet::preProcessBCs(moduleNameVec);
     }
 
-    SVFModule* svfModule = LLVMModuleSet::buildSVFModule(moduleNameVec);
-    SVFIRBuilder builder(svfModule);
-    SVFIR* pag = builder.build();
+    SVFIR* pag = SVFIRCache::build(moduleNameVec);
 
     MTA mta;
     mta.runOnModule(pag);
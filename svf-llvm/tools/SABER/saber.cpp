@@ -27,7 +27,7 @@
  */
 
 #include "SVF-LLVM/LLVMUtil.h"
-#include "SVF-LLVM/SVFIRBuilder.h"
+#include "SVF-LLVM/SVFIRCache.h"
 #include "SABER/LeakChecker.h"
 #include "SABER/FileChecker.h"
 #include "SABER/DoubleFreeChecker.h"
@@ -70,9 +70,7 @@ int main(int argc, char ** argv)
         LLVMModuleSet::preProcessBCs(moduleNameVec);
     }
 
-    SVFModule* svfModule = LLVMModuleSet::buildSVFModule(moduleNameVec);
-    SVFIRBuilder builder(svfModule);
-    SVFIR* pag = builder.build();
+    SVFIR* pag = SVFIRCache::build(moduleNameVec);
 
     std::unique_ptr<LeakChecker> saber;
 
@@ -27,7 +27,7 @@
  */
 
 #include "SVF-LLVM/LLVMUtil.h"
-#include "SVF-LLVM/SVFIRBuilder.h"
+#include "SVF-LLVM/SVFIRCache.h"
 #include "WPA/WPAPass.h"
 #include "Util/CommandLine.h"
 #include "Util/Options.h"
@@ -58,11 +58,8 @@ int main(int argc, char** argv)
             LLVMModuleSet::preProcessBCs(moduleNameVec);
         }
 
-        SVFModule* svfModule = LLVMModuleSet::buildSVFModule(moduleNameVec);
-
         /// Build SVFIR
-        SVFIRBuilder builder(svfModule);
-        pag = builder.build();
+        pag = SVFIRCache::build(moduleNameVec);
     }
 
     WPAPass wpa;
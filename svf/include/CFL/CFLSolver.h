@@ -369,6 +369,164 @@ public:
     void addArc(NodeID src, NodeID dst);
     void meld(NodeID x, TreeNode* uNode, TreeNode* vNode);
 };
+
+/*!
+ * Bit-matrix CFL-reachability solver.
+ * The relation of each grammar symbol is kept as a pair of sparse bit-matrices (rows of
+ * successors and rows of predecessors, indexed by node ID). Instead of processing one edge
+ * at a time, productions are applied semi-naively, round by round, to the rows added in the
+ * previous round (the delta): X -> Y ORs delta rows of Y into rows of X, X -> Y Z ORs the
+ * Z rows of the delta successors of Y into rows of X, and X -> Z Y ORs delta rows of Y into
+ * the X rows of their Z predecessors. The CFL graph gets the derived edges when a solve ends.
+ */
+class BitMatrixCFLSolver : public CFLSolver
+{
+public:
+    typedef std::vector<NodeBS> BitMatrix;
+    /// Symbol (as u32_t) -> rows
+    typedef Map<u32_t, BitMatrix> SymbolToMatrix;
+
+    BitMatrixCFLSolver(CFLGraph* _graph, CFGrammar* _grammar) : CFLSolver(_graph, _grammar), initialized(false)
+    {
+    }
+
+    /// Load the edges of the graph and of the epsilon productions
+    virtual void initialize();
+
+    /// Solve until no new edge is derived from the pending edges
+    virtual void solve();
+
+    /// Edges added to the graph from outside (e.g., on-the-fly call graph) are pending until the next solve
+    virtual inline bool pushIntoWorklist(const CFLEdge* item)
+    {
+        if (item == nullptr)
+            return false;
+        pending.push_back(item);
+        return true;
+    }
+    virtual inline bool isWorklistEmpty()
+    {
+        return pending.empty();
+    }
+
+    /// Whether X(src,dst) has been derived
+    bool hasEdge(NodeID src, NodeID dst, Label X) const;
+
+protected:
+    /// Add X(src,dst) to the relation and to the next delta if it is new
+    void addEdge(NodeID src, NodeID dst, Label X, SymbolToMatrix& nextDelta);
+    /// Add the new part of row src of X to the relation and to the next delta
+    void addRow(NodeID src, const NodeBS& dsts, u32_t X, SymbolToMatrix& nextDelta);
+    /// Apply all productions to delta, returning the edges they derive which are new
+    void applyProductions(const SymbolToMatrix& delta, SymbolToMatrix& nextDelta);
+    /// Add the derived edges to the CFL graph
+    void addDerivedEdges();
+
+    inline NodeBS& getRow(BitMatrix& matrix, NodeID id)
+    {
+        if (matrix.size() <= id)
+            matrix.resize(id + 1);
+        return matrix[id];
+    }
+
+    /// Successor/predecessor rows of each symbol
+    SymbolToMatrix succs;
+    SymbolToMatrix preds;
+    /// Edges derived by the solver and not yet in the graph
+    SymbolToMatrix derived;
+    std::vector<const CFLEdge*> pending;
+    bool initialized;
+};
+
+/*!
+ * Solver keeping derived edges as packed (src, dst, label) triples in an append-only arena,
+ * deduplicated through an open-addressing table of arena indices. The arena doubles as the
+ * FIFO worklist. Only the edges of the start symbol (all edges with -print-cfl) are added to
+ * the CFL graph, once solving is done.
+ */
+class CompactCFLSolver : public CFLSolver
+{
+public:
+    /// A derived edge label(src,dst)
+    struct EdgeTriple
+    {
+        NodeID src;
+        NodeID dst;
+        u32_t label;
+    };
+    typedef std::vector<EdgeTriple> EdgeArena;
+    /// (node, label) -> position of its successors or predecessors in adjLists
+    typedef Map<u64_t, u32_t> AdjacencyMap;
+
+    CompactCFLSolver(CFLGraph* _graph, CFGrammar* _grammar) :
+        CFLSolver(_graph, _grammar), next(0), materialized(0), initialized(false)
+    {
+    }
+
+    /// Load the edges of the graph and of the epsilon productions
+    virtual void initialize();
+
+    /// Process edges in the arena until all of them are processed
+    virtual void solve();
+
+    virtual inline bool pushIntoWorklist(const CFLEdge* item)
+    {
+        if (item == nullptr)
+            return false;
+        return addEdge(item->getSrcID(), item->getDstID(), item->getEdgeKind());
+    }
+    virtual inline bool isWorklistEmpty()
+    {
+        return next == arena.size();
+    }
+
+    /// Whether label(src,dst) has been derived
+    bool hasEdge(NodeID src, NodeID dst, u32_t label) const;
+
+protected:
+    /// Append label(src,dst) to the arena if it is new
+    bool addEdge(NodeID src, NodeID dst, u32_t label);
+    /// Apply all productions having the label of the triple on their right-hand side
+    void processTriple(const EdgeTriple& triple);
+    /// Add the derived edges needed by clients to the CFL graph
+    void addDerivedEdges();
+
+    static inline u64_t getAdjKey(NodeID id, u32_t label)
+    {
+        return ((u64_t)id << 32) | label;
+    }
+    static inline size_t hashTriple(NodeID src, NodeID dst, u32_t label)
+    {
+        u64_t h = getAdjKey(src, label) * 0x9E3779B97F4A7C15ULL;
+        h ^= (h >> 29) + dst * 0xBF58476D1CE4E5B9ULL;
+        return h ^ (h >> 32);
+    }
+    /// Slot of the triple in the index table, or of the empty slot where it would be
+    size_t findSlot(NodeID src, NodeID dst, u32_t label) const;
+    /// Double the index table
+    void growIndex();
+    /// Neighbour list of (id, label) in adjMap, created if absent
+    inline u32_t getAdjList(AdjacencyMap& adjMap, NodeID id, u32_t label)
+    {
+        std::pair<AdjacencyMap::iterator, bool> res = adjMap.emplace(getAdjKey(id, label), adjLists.size());
+        if (res.second)
+            adjLists.emplace_back();
+        return res.first->second;
+    }
+
+    EdgeArena arena;
+    /// Open-addressing table of arena indices (emptySlot if free)
+    std::vector<u32_t> index;
+    static const u32_t emptySlot = UINT32_MAX;
+    AdjacencyMap succs;
+    AdjacencyMap preds;
+    std::vector<std::vector<NodeID>> adjLists;
+    /// Arena index of the next triple to process
+    size_t next;
+    /// Triples before this index have been added to the graph if needed
+    size_t materialized;
+    bool initialized;
+};
 }
 
 #endif /* INCLUDE_CFL_CFLSolver_H_*/
\ No newline at end of file
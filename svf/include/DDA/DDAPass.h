@@ -89,8 +89,17 @@ private:
     void collectCxtInsenEdgeForRecur(PointerAnalysis* pta, const SVFG* svfg,SVFGEdgeSet& insensitveEdges);
     void collectCxtInsenEdgeForVFCycle(PointerAnalysis* pta, const SVFG* svfg,const SVFGSCC* svfgSCC, SVFGEdgeSet& insensitveEdges);
 
+    /// Query server mode (-dda-server), one request and one reply per line
+    //@{
+    void serveQueries(const std::string& endpoint);
+    void serveQueriesOnSocket(const std::string& path);
+    std::string answerQuery(const std::string& request, bool& quit);
+    bool getQueryNode(const std::string& token, NodeID& id);
+    //@}
+
     std::unique_ptr<PointerAnalysis> _pta;	///<  pointer analysis to be executed.
     DDAClient* _client;		///<  DDA client used
+    Map<std::string, NodeID> queryNameToNode;	///<  value names accepted by the query server
 
 };
 
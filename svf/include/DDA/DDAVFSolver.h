@@ -36,6 +36,7 @@
 #include "Util/SCC.h"
 #include "MemoryModel/PointsTo.h"
 #include <algorithm>
+#include <list>
 
 namespace SVF
 {
@@ -60,9 +61,14 @@ public:
     typedef OrderedSet<const SVFGEdge* > ConstSVFGEdgeSet;
     typedef SVFGEdge::SVFGEdgeSetTy SVFGEdgeSet;
     typedef OrderedMap<const SVFGNode*, DPTItemSet> StoreToPMSetMap;
+    typedef std::list<DPIm> DPImLRUList;
+    /// Position in the LRU list and estimated size of a cached points-to set
+    typedef std::pair<typename DPImLRUList::iterator, size_t> CacheEntry;
+    typedef OrderedMap<DPIm, CacheEntry> DPImToCacheEntryMap;
 
     ///Constructor
-    DDAVFSolver(): outOfBudgetQuery(false),_pag(nullptr),_svfg(nullptr),_ander(nullptr),_callGraph(nullptr), _callGraphSCC(nullptr), _svfgSCC(nullptr), ddaStat(nullptr)
+    DDAVFSolver(): outOfBudgetQuery(false),_pag(nullptr),_svfg(nullptr),_ander(nullptr),_callGraph(nullptr), _callGraphSCC(nullptr), _svfgSCC(nullptr), ddaStat(nullptr),
+        cacheBudget(static_cast<size_t>(Options::DDACacheBudget()) << 20), cachedBytes(0)
     {
     }
     /// Destructor
@@ -140,6 +146,7 @@ public:
 
         if(isbkVisited(dpm))
         {
+            touchCachedPointsTo(dpm);
             const CPtSet& cpts = getCachedPointsTo(dpm);
             DBOUT(DDDA, SVFUtil::outs() << "\t already backward visited dpm: ");
             DBOUT(DDDA, dpm.dump());
@@ -319,6 +326,7 @@ protected:
     {
         if(outOfBudgetQuery)
             OOBResetVisited();
+        evictCachedPointsTo();
 
         locToDpmSetMap.clear();
         dpmToloadDpmMap.clear();
@@ -562,6 +570,7 @@ protected:
             reCompute(dpm);
             DOSTAT(ddaStat->_AnaTimeCyclePerQuery += DDAStat::getClk(true) - start);
         }
+        touchCachedPointsTo(dpm);
     }
     virtual inline const CPtSet& getCachedTLPointsTo(const DPIm& dpm)
     {
@@ -573,6 +582,51 @@ protected:
     }
     //@}
 
+    /// Bounded points-to caching across queries (-dda-cache-mb).
+    /// Cached dpms are kept in LRU order and evicted between queries, which is
+    /// safe since every visited dpm holds its complete points-to set then.
+    /// An evicted dpm is simply recomputed when a later query reaches it.
+    //@{
+    inline void touchCachedPointsTo(const DPIm& dpm)
+    {
+        if (cacheBudget == 0 || !isEvictable(dpm))
+            return;
+        size_t bytes = 3 * sizeof(DPIm) + sizeof(CPtSet) + getCachedPointsTo(dpm).count() * sizeof(CVar);
+        typename DPImToCacheEntryMap::iterator it = cacheEntries.find(dpm);
+        if (it == cacheEntries.end())
+        {
+            lruDpms.push_front(dpm);
+            cacheEntries[dpm] = std::make_pair(lruDpms.begin(), bytes);
+        }
+        else
+        {
+            lruDpms.splice(lruDpms.begin(), lruDpms, it->second.first);
+            cachedBytes -= it->second.second;
+            it->second.second = bytes;
+        }
+        cachedBytes += bytes;
+    }
+    inline void evictCachedPointsTo()
+    {
+        while (cachedBytes > cacheBudget && !lruDpms.empty())
+        {
+            const DPIm& dpm = lruDpms.back();
+            typename DPImToCacheEntryMap::iterator it = cacheEntries.find(dpm);
+            cachedBytes -= it->second.second;
+            dpmToTLCPtSetMap.erase(dpm);
+            dpmToADCPtSetMap.erase(dpm);
+            backwardVisited.erase(dpm);
+            outOfBudgetDpms.erase(dpm);
+            cacheEntries.erase(it);
+            lruDpms.pop_back();
+        }
+    }
+    virtual inline bool isEvictable(const DPIm&)
+    {
+        return true;
+    }
+    //@}
+
     /// Whether this is a top-level pointer statement
     inline bool isTopLevelPtrStmt(const SVFGNode* stmt)
     {
@@ -782,6 +836,10 @@ protected:
     StoreToPMSetMap storeToDPMs;	///< map store to set of DPM which have been stong updated there
     DDAStat* ddaStat;				///< DDA stat
     SVFGBuilder svfgBuilder;			///< SVFG Builder
+    size_t cacheBudget;				///< budget of the points-to cache in bytes (0: unbounded)
+    size_t cachedBytes;				///< estimated size of the points-to cache
+    DPImLRUList lruDpms;			///< cached dpms, most recently used first
+    DPImToCacheEntryMap cacheEntries;	///< cached dpms and their LRU positions
 };
 
 } // End namespace SVF
@@ -155,6 +155,11 @@ public:
     {
         return getPts(dpm.getCurNodeID());
     }
+    /// Top-level points-to sets double as query results, keep them
+    virtual inline bool isEvictable(const LocDPItem& dpm) override
+    {
+        return !isTopLevelPtrStmt(dpm.getLoc());
+    }
     //@}
 
     /// Union pts
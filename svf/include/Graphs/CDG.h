@@ -127,7 +127,7 @@ class CDG : public GenericCDGTy
 
 public:
 
-    typedef Map<NodeID, CDGNode *> CDGNodeIDToNodeMapTy;
+    typedef GenericCDGTy::IDToNodeMapTy CDGNodeIDToNodeMapTy;
     typedef CDGEdge::CDGEdgeSetTy CDGEdgeSetTy;
     typedef CDGNodeIDToNodeMapTy::iterator iterator;
     typedef CDGNodeIDToNodeMapTy::const_iterator const_iterator;
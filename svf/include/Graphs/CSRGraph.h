@@ -0,0 +1,434 @@
+//===- CSRGraph.h -- Read-only snapshot of a generic graph -------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * CSRGraph.h
+ *
+ * A CSRGraph freezes a finished GenericGraph (e.g., ICFG, SVFG, PTACallGraph)
+ * into contiguous arrays indexed by node ID: the incoming and outgoing edges of
+ * each node are a slice of one array, sorted by edge kind so that the edges of
+ * one kind are a sub-range. Graph algorithms written against GenericGraphTraits
+ * (e.g., SCCDetection, GraphReachSolver) run on a CSRGraph without visiting the
+ * edge sets of the original nodes.
+ *
+ * The snapshot refers to the nodes and edges of the original graph, which must
+ * be neither changed nor deleted while the snapshot is used. All edges of a node
+ * are its direct edges, so graphs overriding directOutEdgeBegin() and the like
+ * (e.g., the constraint graph) should not be frozen.
+ */
+
+#ifndef INCLUDE_GRAPHS_CSRGRAPH_H_
+#define INCLUDE_GRAPHS_CSRGRAPH_H_
+
+#include "Graphs/GenericGraph.h"
+#include "Util/iterator_range.h"
+#include <algorithm>
+
+namespace SVF
+{
+
+template<class NodeTy, class EdgeTy> class CSRGraph;
+
+/*!
+ * Node of a CSRGraph, wrapping a node of the original graph
+ */
+template<class NodeTy, class EdgeTy>
+class CSRNode
+{
+    friend class CSRGraph<NodeTy, EdgeTy>;
+
+public:
+    typedef NodeTy OrigNodeType;
+    typedef EdgeTy EdgeType;
+    typedef typename EdgeTy::GEdgeKind GEdgeKind;
+
+    /// An edge and the snapshot node at its other end
+    struct Adjacency
+    {
+        EdgeType* edge;
+        CSRNode* node;
+    };
+    typedef const Adjacency* edge_iterator;
+    typedef iter_range<edge_iterator> EdgeRange;
+
+    /// Iterator over the adjacent nodes, where getCurrent() points to the edge
+    class ChildIterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef CSRNode* value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef CSRNode** pointer;
+        typedef CSRNode*& reference;
+
+        explicit ChildIterator(edge_iterator it) : I(it) {}
+
+        inline CSRNode* operator*() const
+        {
+            return I->node;
+        }
+        inline EdgeType* const* getCurrent() const
+        {
+            return &I->edge;
+        }
+        inline ChildIterator& operator++()
+        {
+            ++I;
+            return *this;
+        }
+        inline ChildIterator operator++(int)
+        {
+            ChildIterator tmp = *this;
+            ++I;
+            return tmp;
+        }
+        inline bool operator==(const ChildIterator& rhs) const
+        {
+            return I == rhs.I;
+        }
+        inline bool operator!=(const ChildIterator& rhs) const
+        {
+            return I != rhs.I;
+        }
+
+    private:
+        edge_iterator I;
+    };
+
+    CSRNode() : id(0), node(nullptr), outBegin(nullptr), outEnd(nullptr), inBegin(nullptr), inEnd(nullptr) {}
+
+    /// Get ID
+    inline NodeID getId() const
+    {
+        return id;
+    }
+    /// Get the node of the original graph
+    inline OrigNodeType* getNode() const
+    {
+        return node;
+    }
+
+    /// Incoming/outgoing edges, sorted by edge kind
+    //@{
+    inline edge_iterator OutEdgeBegin() const
+    {
+        return outBegin;
+    }
+    inline edge_iterator OutEdgeEnd() const
+    {
+        return outEnd;
+    }
+    inline edge_iterator InEdgeBegin() const
+    {
+        return inBegin;
+    }
+    inline edge_iterator InEdgeEnd() const
+    {
+        return inEnd;
+    }
+    inline EdgeRange getOutEdges() const
+    {
+        return EdgeRange(outBegin, outEnd);
+    }
+    inline EdgeRange getInEdges() const
+    {
+        return EdgeRange(inBegin, inEnd);
+    }
+    //@}
+
+    /// Incoming/outgoing edges of the given kind
+    //@{
+    inline EdgeRange getOutEdgesWithKind(GEdgeKind kind) const
+    {
+        return getEdgesWithKind(outBegin, outEnd, kind);
+    }
+    inline EdgeRange getInEdgesWithKind(GEdgeKind kind) const
+    {
+        return getEdgesWithKind(inBegin, inEnd, kind);
+    }
+    //@}
+
+    /// Number of incoming/outgoing edges
+    //@{
+    inline u32_t getOutEdgeNum() const
+    {
+        return outEnd - outBegin;
+    }
+    inline u32_t getInEdgeNum() const
+    {
+        return inEnd - inBegin;
+    }
+    //@}
+
+private:
+    static inline EdgeRange getEdgesWithKind(edge_iterator begin, edge_iterator end, GEdgeKind kind)
+    {
+        edge_iterator lo = std::lower_bound(begin, end, kind, [](const Adjacency& adj, GEdgeKind k)
+        {
+            return adj.edge->getEdgeKind() < k;
+        });
+        edge_iterator hi = std::upper_bound(lo, end, kind, [](GEdgeKind k, const Adjacency& adj)
+        {
+            return k < adj.edge->getEdgeKind();
+        });
+        return EdgeRange(lo, hi);
+    }
+
+    NodeID id;
+    OrigNodeType* node;
+    edge_iterator outBegin;
+    edge_iterator outEnd;
+    edge_iterator inBegin;
+    edge_iterator inEnd;
+};
+
+/*!
+ * Read-only snapshot of a GenericGraph in compressed sparse row form
+ */
+template<class NodeTy, class EdgeTy>
+class CSRGraph
+{
+public:
+    typedef CSRNode<NodeTy, EdgeTy> NodeType;
+    typedef EdgeTy EdgeType;
+    typedef GenericGraph<NodeTy, EdgeTy> OrigGraphType;
+    typedef typename NodeType::Adjacency Adjacency;
+    typedef std::vector<NodeType*> NodeList;
+
+    /// Node Iterators, in the order of node IDs
+    //@{
+    typedef typename NodeList::const_iterator iterator;
+    typedef typename NodeList::const_iterator const_iterator;
+    //@}
+
+    /// Freeze the graph
+    explicit CSRGraph(const OrigGraphType* graph) : edgeNum(0)
+    {
+        NodeID maxId = 0;
+        u32_t outNum = 0;
+        u32_t inNum = 0;
+        for (const auto& it : *graph)
+        {
+            maxId = std::max(maxId, it.first);
+            outNum += it.second->getOutEdges().size();
+            inNum += it.second->getInEdges().size();
+        }
+        nodes.resize(graph->begin() == graph->end() ? 0 : maxId + 1);
+        nodeList.reserve(graph->getTotalNodeNum());
+        for (const auto& it : *graph)
+        {
+            NodeType& csrNode = nodes[it.first];
+            csrNode.id = it.first;
+            csrNode.node = it.second;
+            nodeList.push_back(&csrNode);
+        }
+
+        /// The adjacency arrays are not reallocated once reserved, so nodes can point into them
+        outAdj.reserve(outNum);
+        inAdj.reserve(inNum);
+        for (NodeType* csrNode : nodeList)
+        {
+            size_t outStart = outAdj.size();
+            for (EdgeType* edge : csrNode->node->getOutEdges())
+                outAdj.push_back({edge, &nodes[edge->getDstID()]});
+            sortByKind(outStart, outAdj);
+            csrNode->outBegin = outAdj.data() + outStart;
+            csrNode->outEnd = outAdj.data() + outAdj.size();
+
+            size_t inStart = inAdj.size();
+            for (EdgeType* edge : csrNode->node->getInEdges())
+                inAdj.push_back({edge, &nodes[edge->getSrcID()]});
+            sortByKind(inStart, inAdj);
+            csrNode->inBegin = inAdj.data() + inStart;
+            csrNode->inEnd = inAdj.data() + inAdj.size();
+        }
+        edgeNum = outAdj.size();
+    }
+
+    /// Nodes point into the arrays of this snapshot
+    CSRGraph(const CSRGraph&) = delete;
+    CSRGraph& operator=(const CSRGraph&) = delete;
+
+    /// Iterators
+    //@{
+    inline const_iterator begin() const
+    {
+        return nodeList.begin();
+    }
+    inline const_iterator end() const
+    {
+        return nodeList.end();
+    }
+    //@}
+
+    /// Get a node
+    //@{
+    inline NodeType* getGNode(NodeID id)
+    {
+        assert(hasGNode(id) && "Node not found!");
+        return &nodes[id];
+    }
+    inline const NodeType* getGNode(NodeID id) const
+    {
+        assert(hasGNode(id) && "Node not found!");
+        return &nodes[id];
+    }
+    //@}
+
+    /// Has a node
+    inline bool hasGNode(NodeID id) const
+    {
+        return id < nodes.size() && nodes[id].node != nullptr;
+    }
+
+    /// Get total number of node/edge
+    inline u32_t getTotalNodeNum() const
+    {
+        return nodeList.size();
+    }
+    inline u32_t getTotalEdgeNum() const
+    {
+        return edgeNum;
+    }
+
+private:
+    /// Sort adjacencies from start to the end of the array by edge kind, keeping their original order otherwise
+    static inline void sortByKind(size_t start, std::vector<Adjacency>& adj)
+    {
+        std::stable_sort(adj.begin() + start, adj.end(), [](const Adjacency& lhs, const Adjacency& rhs)
+        {
+            return lhs.edge->getEdgeKind() < rhs.edge->getEdgeKind();
+        });
+    }
+
+    std::vector<NodeType> nodes;    ///< nodes indexed by ID, with null original node if absent
+    NodeList nodeList;              ///< nodes present in the graph
+    std::vector<Adjacency> outAdj;  ///< outgoing edges of all nodes
+    std::vector<Adjacency> inAdj;   ///< incoming edges of all nodes
+    u32_t edgeNum;
+};
+
+/*!
+ * GenericGraphTraits for nodes of a CSRGraph
+ */
+template<class NodeTy,class EdgeTy> struct GenericGraphTraits<SVF::CSRNode<NodeTy,EdgeTy>*>
+{
+    typedef SVF::CSRNode<NodeTy,EdgeTy> NodeType;
+    typedef EdgeTy EdgeType;
+    typedef NodeType* NodeRef;
+    typedef typename NodeType::ChildIterator ChildIteratorType;
+
+    static NodeType* getEntryNode(NodeType* N)
+    {
+        return N;
+    }
+
+    static inline ChildIteratorType child_begin(const NodeType* N)
+    {
+        return ChildIteratorType(N->OutEdgeBegin());
+    }
+    static inline ChildIteratorType child_end(const NodeType* N)
+    {
+        return ChildIteratorType(N->OutEdgeEnd());
+    }
+    static inline ChildIteratorType direct_child_begin(const NodeType* N)
+    {
+        return ChildIteratorType(N->OutEdgeBegin());
+    }
+    static inline ChildIteratorType direct_child_end(const NodeType* N)
+    {
+        return ChildIteratorType(N->OutEdgeEnd());
+    }
+};
+
+/*!
+ * Inverse GenericGraphTraits for nodes of a CSRGraph, which is used for inverse traversal.
+ */
+template<class NodeTy,class EdgeTy>
+struct GenericGraphTraits<Inverse<SVF::CSRNode<NodeTy,EdgeTy>*>>
+{
+    typedef SVF::CSRNode<NodeTy,EdgeTy> NodeType;
+    typedef EdgeTy EdgeType;
+    typedef NodeType* NodeRef;
+    typedef typename NodeType::ChildIterator ChildIteratorType;
+
+    static inline NodeType* getEntryNode(Inverse<NodeType*> G)
+    {
+        return G.Graph;
+    }
+
+    static inline ChildIteratorType child_begin(const NodeType* N)
+    {
+        return ChildIteratorType(N->InEdgeBegin());
+    }
+    static inline ChildIteratorType child_end(const NodeType* N)
+    {
+        return ChildIteratorType(N->InEdgeEnd());
+    }
+
+    static inline unsigned getNodeID(const NodeType* N)
+    {
+        return N->getId();
+    }
+};
+
+/*!
+ * GenericGraphTraits for CSRGraph
+ */
+template<class NodeTy,class EdgeTy> struct GenericGraphTraits<SVF::CSRGraph<NodeTy,EdgeTy>*> : public GenericGraphTraits<SVF::CSRNode<NodeTy,EdgeTy>*>
+{
+    typedef SVF::CSRGraph<NodeTy,EdgeTy> GraphTy;
+    typedef SVF::CSRNode<NodeTy,EdgeTy> NodeType;
+    typedef typename GraphTy::const_iterator nodes_iterator;
+
+    static NodeType* getEntryNode(GraphTy*)
+    {
+        return nullptr;
+    }
+
+    static nodes_iterator nodes_begin(GraphTy* G)
+    {
+        return G->begin();
+    }
+    static nodes_iterator nodes_end(GraphTy* G)
+    {
+        return G->end();
+    }
+
+    static unsigned graphSize(GraphTy* G)
+    {
+        return G->getTotalNodeNum();
+    }
+
+    static inline unsigned getNodeID(const NodeType* N)
+    {
+        return N->getId();
+    }
+    static NodeType* getNode(GraphTy* G, SVF::NodeID id)
+    {
+        return G->getGNode(id);
+    }
+};
+
+} // End namespace SVF
+
+#endif /* INCLUDE_GRAPHS_CSRGRAPH_H_ */
@@ -32,6 +32,7 @@
 
 #include "Graphs/ConsGEdge.h"
 #include "Graphs/ConsGNode.h"
+#include "Util/UnionFind.h"
 
 namespace SVF
 {
@@ -45,16 +46,13 @@ class ConstraintGraph :  public GenericGraph<ConstraintNode,ConstraintEdge>
 {
 
 public:
-    typedef OrderedMap<NodeID, ConstraintNode *> ConstraintNodeIDToNodeMapTy;
+    typedef GenericGraph<ConstraintNode,ConstraintEdge>::IDToNodeMapTy ConstraintNodeIDToNodeMapTy;
     typedef ConstraintEdge::ConstraintEdgeSetTy::iterator ConstraintNodeIter;
-    typedef Map<NodeID, NodeID> NodeToRepMap;
-    typedef Map<NodeID, NodeBS> NodeToSubsMap;
     typedef FIFOWorkList<NodeID> WorkList;
 
 protected:
     SVFIR* pag;
-    NodeToRepMap nodeToRepMap;
-    NodeToSubsMap nodeToSubsMap;
+    UnionFind nodeReps;     ///< nodes merged by SCC/PWC and field collapsing
     WorkList nodesToBeCollapsed;
     EdgeID edgeIndex;
 
@@ -232,40 +230,22 @@ public:
     //@{
     inline NodeID sccRepNode(NodeID id) const
     {
-        NodeToRepMap::const_iterator it = nodeToRepMap.find(id);
-        if(it==nodeToRepMap.end())
-            return id;
-        else
-            return it->second;
+        return nodeReps.find(id);
     }
-    inline NodeBS& sccSubNodes(NodeID id)
+    /// Nodes merged into rep, including rep
+    inline NodeBS sccSubNodes(NodeID rep) const
     {
-        nodeToSubsMap[id].set(id);
-        return nodeToSubsMap[id];
+        return nodeReps.members(rep);
     }
+    /// Merge node and its sub nodes into rep
     inline void setRep(NodeID node, NodeID rep)
     {
-        nodeToRepMap[node] = rep;
-    }
-    inline void setSubs(NodeID node, NodeBS& subs)
-    {
-        nodeToSubsMap[node] |= subs;
-    }
-    inline void resetSubs(NodeID node)
-    {
-        nodeToSubsMap.erase(node);
-    }
-    inline NodeBS& getSubs(NodeID node)
-    {
-        return nodeToSubsMap[node];
-    }
-    inline NodeID getRep(NodeID node)
-    {
-        return nodeToRepMap[node];
+        nodeReps.merge(node, rep);
     }
+    /// Take node out of the nodes merged with it
     inline void resetRep(NodeID node)
     {
-        nodeToRepMap.erase(node);
+        nodeReps.isolate(node);
     }
     //@}
 
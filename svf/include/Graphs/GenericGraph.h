@@ -33,6 +33,7 @@
 #include "SVFIR/SVFType.h"
 #include "Util/iterator.h"
 #include "Graphs/GraphTraits.h"
+#include <algorithm>
 
 namespace SVF
 {
@@ -336,6 +337,282 @@ public:
     //@}
 };
 
+/*!
+ * Table of graph nodes indexed by node ID. It is used like an OrderedMap<NodeID, NodeType*>
+ * (nodes are visited in ascending ID order, and iterators stay valid when nodes are added or
+ * removed), but looking up a node is an array access. Node IDs are mostly dense. IDs far
+ * beyond the number of nodes (e.g., with -node-alloc-strat=dense) are kept in an ordered
+ * overflow map, and move to the array once it grows past them.
+ */
+template<class NodeType>
+class IDToNodeTable
+{
+public:
+    typedef NodeID key_type;
+    typedef NodeType* mapped_type;
+    typedef std::pair<const NodeID, NodeType*> value_type;
+    typedef size_t size_type;
+
+private:
+    typedef std::vector<value_type> SlotVector;
+    typedef OrderedMap<NodeID, NodeType*> OverflowMap;
+    /// Position of the end iterator
+    static constexpr size_t endIdx = ~(size_t)0;
+    /// IDs below twice the number of nodes plus this are stored in the array
+    static constexpr size_t denseSlack = 1024;
+
+    /// An iterator is the ID of the node it points to, so it does not depend on where the node is stored
+    template<class TableTy, class ValueTy>
+    class Iterator
+    {
+        friend class IDToNodeTable;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef typename IDToNodeTable::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef ValueTy* pointer;
+        typedef ValueTy& reference;
+
+        Iterator() : table(nullptr), idx(endIdx) {}
+        Iterator(TableTy* t, size_t i) : table(t), idx(i) {}
+        /// Conversion from iterator to const_iterator
+        template<class OtherTableTy, class OtherValueTy>
+        Iterator(const Iterator<OtherTableTy, OtherValueTy>& it) : table(it.table), idx(it.idx) {}
+
+        inline reference operator*() const
+        {
+            return table->getValue(idx);
+        }
+        inline pointer operator->() const
+        {
+            return &table->getValue(idx);
+        }
+        inline Iterator& operator++()
+        {
+            idx = table->next(idx);
+            return *this;
+        }
+        inline Iterator operator++(int)
+        {
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        inline Iterator& operator--()
+        {
+            idx = table->prev(idx);
+            return *this;
+        }
+        inline Iterator operator--(int)
+        {
+            Iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+        inline bool operator==(const Iterator& rhs) const
+        {
+            return idx == rhs.idx;
+        }
+        inline bool operator!=(const Iterator& rhs) const
+        {
+            return idx != rhs.idx;
+        }
+
+    private:
+        TableTy* table;
+        size_t idx;
+
+        template<class, class> friend class Iterator;
+    };
+
+public:
+    typedef Iterator<IDToNodeTable, value_type> iterator;
+    typedef Iterator<const IDToNodeTable, const value_type> const_iterator;
+
+    IDToNodeTable() : num(0) {}
+
+    /// Iterators
+    //@{
+    inline iterator begin()
+    {
+        return iterator(this, first());
+    }
+    inline iterator end()
+    {
+        return iterator(this, endIdx);
+    }
+    inline const_iterator begin() const
+    {
+        return const_iterator(this, first());
+    }
+    inline const_iterator end() const
+    {
+        return const_iterator(this, endIdx);
+    }
+    //@}
+
+    inline iterator find(NodeID id)
+    {
+        return iterator(this, has(id) ? id : endIdx);
+    }
+    inline const_iterator find(NodeID id) const
+    {
+        return const_iterator(this, has(id) ? id : endIdx);
+    }
+    inline size_type count(NodeID id) const
+    {
+        return has(id) ? 1 : 0;
+    }
+
+    /// The node of id, added as nullptr if absent
+    inline NodeType*& operator[](NodeID id)
+    {
+        return getOrAdd(id).second;
+    }
+
+    inline std::pair<iterator, bool> insert(const value_type& val)
+    {
+        bool inserted = !has(val.first);
+        if (inserted)
+            getOrAdd(val.first).second = val.second;
+        return std::make_pair(iterator(this, val.first), inserted);
+    }
+
+    inline void erase(iterator it)
+    {
+        if (it.idx < slots.size())
+        {
+            slots[it.idx].second = nullptr;
+            used[it.idx] = false;
+        }
+        else
+            overflow.erase(it.idx);
+        num--;
+    }
+    inline size_type erase(NodeID id)
+    {
+        if (!has(id))
+            return 0;
+        erase(find(id));
+        return 1;
+    }
+
+    inline size_type size() const
+    {
+        return num;
+    }
+    inline bool empty() const
+    {
+        return num == 0;
+    }
+    inline void clear()
+    {
+        slots.clear();
+        used.clear();
+        overflow.clear();
+        num = 0;
+    }
+
+private:
+    inline bool has(NodeID id) const
+    {
+        if (id < slots.size())
+            return used[id];
+        return overflow.find(id) != overflow.end();
+    }
+
+    inline value_type& getValue(size_t idx)
+    {
+        return idx < slots.size() ? slots[idx] : *overflow.find(idx);
+    }
+    inline const value_type& getValue(size_t idx) const
+    {
+        return idx < slots.size() ? slots[idx] : *overflow.find(idx);
+    }
+
+    inline value_type& getOrAdd(NodeID id)
+    {
+        if (id >= slots.size() && id < 2 * num + denseSlack)
+            grow(id);
+        if (id < slots.size())
+        {
+            if (!used[id])
+            {
+                used[id] = true;
+                num++;
+            }
+            return slots[id];
+        }
+        std::pair<typename OverflowMap::iterator, bool> res = overflow.emplace(id, nullptr);
+        if (res.second)
+            num++;
+        return *res.first;
+    }
+
+    /// Extend the array to hold id, moving the nodes in the overflow map it now covers
+    void grow(NodeID id)
+    {
+        if (slots.capacity() <= id)
+            slots.reserve(std::max<size_t>(id + 1, 2 * slots.capacity()));
+        for (NodeID i = slots.size(); i <= id; ++i)
+            slots.emplace_back(i, nullptr);
+        used.resize(id + 1, false);
+        while (!overflow.empty() && overflow.begin()->first <= id)
+        {
+            slots[overflow.begin()->first].second = overflow.begin()->second;
+            used[overflow.begin()->first] = true;
+            overflow.erase(overflow.begin());
+        }
+    }
+
+    /// Position of the first node
+    inline size_t first() const
+    {
+        return nextUsed(0);
+    }
+    /// Position of the node after idx
+    inline size_t next(size_t idx) const
+    {
+        if (idx < slots.size())
+            return nextUsed(idx + 1);
+        typename OverflowMap::const_iterator it = overflow.upper_bound(idx);
+        return it == overflow.end() ? endIdx : it->first;
+    }
+    /// Position of the node before idx
+    inline size_t prev(size_t idx) const
+    {
+        if (idx >= slots.size())
+        {
+            typename OverflowMap::const_iterator it = idx == endIdx ? overflow.end() : overflow.find(idx);
+            if (it != overflow.begin())
+                return (--it)->first;
+            idx = slots.size();
+        }
+        while (idx > 0)
+            if (used[--idx])
+                return idx;
+        assert(false && "decrementing the first iterator");
+        return endIdx;
+    }
+    /// First node from array slot idx on, which may be in the overflow map
+    inline size_t nextUsed(size_t idx) const
+    {
+        for (; idx < used.size(); ++idx)
+            if (used[idx])
+                return idx;
+        return overflow.empty() ? endIdx : overflow.begin()->first;
+    }
+
+    SlotVector slots;           ///< slot i holds the node of ID i
+    std::vector<bool> used;     ///< whether slot i holds a node
+    OverflowMap overflow;       ///< nodes whose IDs are beyond the array
+    size_t num;                 ///< number of nodes
+};
+
+template<class NodeType> constexpr size_t IDToNodeTable<NodeType>::endIdx;
+template<class NodeType> constexpr size_t IDToNodeTable<NodeType>::denseSlack;
+
 /*
  * Generic graph for program representation
  * It is base class and needs to be instantiated
@@ -351,8 +628,12 @@ class GenericGraph
 public:
     typedef NodeTy NodeType;
     typedef EdgeTy EdgeType;
-    /// NodeID to GenericNode map
+    /// NodeID to GenericNode map, an ID-indexed table unless built with SVF_ORDERED_NODE_MAP
+#ifdef SVF_ORDERED_NODE_MAP
     typedef OrderedMap<NodeID, NodeType*> IDToNodeMapTy;
+#else
+    typedef IDToNodeTable<NodeType> IDToNodeMapTy;
+#endif
 
     /// Node Iterators
     //@{
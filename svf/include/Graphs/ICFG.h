@@ -52,7 +52,7 @@ class ICFG : public GenericICFGTy
 
 public:
 
-    typedef OrderedMap<NodeID, ICFGNode *> ICFGNodeIDToNodeMapTy;
+    typedef GenericICFGTy::IDToNodeMapTy ICFGNodeIDToNodeMapTy;
     typedef ICFGEdge::ICFGEdgeSetTy ICFGEdgeSetTy;
     typedef ICFGNodeIDToNodeMapTy::iterator iterator;
     typedef ICFGNodeIDToNodeMapTy::const_iterator const_iterator;
@@ -271,6 +271,14 @@ public:
     virtual void readFile(const std::string& filename);
     virtual MRVer* getMRVERFromString(const std::string& input);
 
+    /// Compact binary format with interned memory regions and varint-encoded records.
+    /// readFile detects this format by its header and forwards to readBinaryFile.
+    //@{
+    virtual void writeToBinaryFile(const std::string& filename);
+    virtual void readBinaryFile(const std::string& filename);
+    static bool isBinarySVFGFile(const std::string& filename);
+    //@}
+
 protected:
     /// Add indirect def-use edges of a memory region between two statements,
     //@{
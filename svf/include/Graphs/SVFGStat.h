@@ -37,6 +37,7 @@
 #define SVFGSTAT_H_
 
 #include "Graphs/SVFG.h"
+#include "Graphs/CSRGraph.h"
 #include "Util/PTAStat.h"
 #include "Util/SCC.h"
 
@@ -94,7 +95,8 @@ class SVFGStat : public PTAStat
 public:
     typedef Set<const SVFGNode*> SVFGNodeSet;
     typedef OrderedSet<const SVFGEdge*> SVFGEdgeSet;
-    typedef SCCDetection<SVFG*> SVFGSCC;
+    typedef CSRGraph<SVFGNode, SVFGEdge> SVFGSnapshot;
+    typedef SCCDetection<SVFGSnapshot*> SVFGSCC;
 
     SVFGStat(SVFG* g);
 
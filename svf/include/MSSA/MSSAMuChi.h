@@ -42,6 +42,7 @@ class MSSADEF;
  */
 class MRVer
 {
+    friend class MemSSA;
 
 public:
     typedef MSSADEF MSSADef;
@@ -58,6 +59,11 @@ public:
         mr(m), version(v), vid(totalVERNum++),def(d)
     {
     }
+    /// Constructor with a given ID (MemSSA numbers its versions once a function is built)
+    MRVer(const MemRegion* m, MRVERSION v, MSSADef* d, MRVERID id) :
+        mr(m), version(v), vid(id),def(d)
+    {
+    }
 
     /// Return the memory region
     inline const MemRegion* getMR() const
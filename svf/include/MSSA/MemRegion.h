@@ -39,6 +39,7 @@
 #include "Util/SCC.h"
 #include "Util/WorkList.h"
 #include "Graphs/ICFG.h"
+#include "MemoryModel/PersistentPointsToCache.h"
 
 #include <set>
 
@@ -168,8 +169,21 @@ public:
     typedef Map<const SVFFunction*, NodeBS> FunToNodeBSMap;
     /// Map a callsite to its indirect refs/mods of memory objects
     typedef Map<const CallICFGNode*, NodeBS> CallSiteToNodeBSMap;
+    /// Map a callsite to the ID of its indirect refs/mods in modRefSets
+    typedef Map<const CallICFGNode*, PointsToID> CallSiteToModRefIDMap;
     //@}
 
+    /// Mod-ref of the functions in a call graph SCC and of their callsites,
+    /// computed by modRefAnalysis and merged into the maps below afterwards
+    struct SCCModRef
+    {
+        NodeID rep;
+        FunToPointsToMap funToRefs;
+        FunToPointsToMap funToMods;
+        CallSiteToPointsToMap csToRefs;
+        CallSiteToPointsToMap csToMods;
+    };
+
     typedef Map<NodeID, NodeBS> NodeToPTSSMap;
 
     /// SVFIR edge list
@@ -228,9 +242,11 @@ private:
     /// Map a function to its indirect defs of memory objects
     FunToPointsToMap funToModsMap;
     /// Map a callsite to its indirect uses of memory objects
-    CallSiteToPointsToMap csToRefsMap;
+    CallSiteToModRefIDMap csToRefsMap;
     /// Map a callsite to its indirect defs of memory objects
-    CallSiteToPointsToMap csToModsMap;
+    CallSiteToModRefIDMap csToModsMap;
+    /// Hash-consed mod/ref sets of callsites, most of which are shared
+    PersistentPointsToCache<NodeBS> modRefSets;
     /// Map a callsite to all its object might pass into its callees
     CallSiteToPointsToMap csToCallSiteArgsPtsMap;
     /// Map a callsite to all its object might return from its callees
@@ -268,8 +284,9 @@ private:
     /// Get all the objects in callee's modref escaped via global objects (the chain pts of globals)
     void getEscapObjviaGlobals(NodeBS& globs, const NodeBS& pts);
 
-    /// Get reverse topo call graph scc
-    void getCallGraphSCCRevTopoOrder(WorkList& worklist);
+    /// Get call graph SCCs (their rep nodes) by levels, where an SCC only
+    /// calls SCCs of lower levels
+    void getCallGraphSCCLevels(std::vector<std::vector<NodeID>>& levels);
 
 protected:
     MRGenerator(BVDataPTAImpl* p, bool ptrOnly);
@@ -329,11 +346,12 @@ protected:
         aliasMRs.insert(mr);
     }
 
-    /// Mod-Ref analysis for callsite invoking this callGraphNode
-    virtual void modRefAnalysis(PTACallGraphNode* callGraphNode, WorkList& worklist);
+    /// Mod-Ref analysis for callsites in an SCC, whose callees in other SCCs have been analysed.
+    /// It only reads the MRGenerator so that SCCs of the same level can be analysed in parallel.
+    virtual void modRefAnalysis(SCCModRef& sccModRef);
 
     /// Get Mod-Ref of a callee function
-    virtual bool handleCallsiteModRef(NodeBS& mod, NodeBS& ref, const CallICFGNode* cs, const SVFFunction* fun);
+    virtual bool handleCallsiteModRef(NodeBS& mod, NodeBS& ref, const CallICFGNode* cs, const SVFFunction* fun, SCCModRef& sccModRef);
 
 
     /// Add cpts to store/load
@@ -380,9 +398,11 @@ protected:
     /// Add indirect def an memory object in the function
     void addModSideEffectOfFunction(const SVFFunction* fun, const NodeBS& mods);
     /// Add indirect uses an memory object in the function
-    bool addRefSideEffectOfCallSite(const CallICFGNode* cs, const NodeBS& refs);
+    bool addRefSideEffectOfCallSite(const CallICFGNode* cs, const NodeBS& refs, SCCModRef& sccModRef);
     /// Add indirect def an memory object in the function
-    bool addModSideEffectOfCallSite(const CallICFGNode* cs, const NodeBS& mods);
+    bool addModSideEffectOfCallSite(const CallICFGNode* cs, const NodeBS& mods, SCCModRef& sccModRef);
+    /// Add the non-local objects of objs into the side-effect set
+    void addNonLocalObjects(NodeBS& sideEffect, const NodeBS& objs, const SVFFunction* fun) const;
 
     /// Get indirect refs of a function
     inline const NodeBS& getRefSideEffectOfFunction(const SVFFunction* fun)
@@ -397,12 +417,12 @@ protected:
     /// Get indirect refs of a callsite
     inline const NodeBS& getRefSideEffectOfCallSite(const CallICFGNode* cs)
     {
-        return csToRefsMap[cs];
+        return modRefSets.getActualPts(csToRefsMap[cs]);
     }
     /// Get indirect mods of a callsite
     inline const NodeBS& getModSideEffectOfCallSite(const CallICFGNode* cs)
     {
-        return csToModsMap[cs];
+        return modRefSets.getActualPts(csToModsMap[cs]);
     }
     /// Has indirect refs of a callsite
     inline bool hasRefSideEffectOfCallSite(const CallICFGNode* cs)
@@ -444,6 +464,14 @@ public:
     {
         return funToMRsMap[fun];
     }
+    inline bool hasLoadMRSet(const LoadStmt* load) const
+    {
+        return loadsToMRsMap.find(load)!=loadsToMRsMap.end();
+    }
+    inline bool hasStoreMRSet(const StoreStmt* store) const
+    {
+        return storesToMRsMap.find(store)!=storesToMRsMap.end();
+    }
     inline MRSet& getLoadMRSet(const LoadStmt* load)
     {
         return loadsToMRsMap[load];
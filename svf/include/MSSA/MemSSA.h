@@ -67,9 +67,20 @@ public:
     typedef MSSAPHI<Condition> PHI;
     typedef MSSADEF MDEF;
 
-    typedef Set<MU*> MUSet;
-    typedef Set<CHI*> CHISet;
-    typedef Set<PHI*> PHISet;
+    /// Mus/chis/phis of a statement, callsite, function or basic block are on
+    /// distinct memory regions and ordered by them rather than by address, so
+    /// that SVFG nodes created from them are numbered the same in every run.
+    template<class T>
+    struct MRIDLess
+    {
+        inline bool operator()(const T* lhs, const T* rhs) const
+        {
+            return lhs->getMR()->getMRID() < rhs->getMR()->getMRID();
+        }
+    };
+    typedef OrderedSet<MU*, MRIDLess<MU>> MUSet;
+    typedef OrderedSet<CHI*, MRIDLess<CHI>> CHISet;
+    typedef OrderedSet<PHI*, MRIDLess<PHI>> PHISet;
 
     ///Define mem region set
     typedef MRGenerator::MRSet MRSet;
@@ -118,18 +129,206 @@ public:
     };
 
 protected:
+    /*!
+     * Memory SSA of a function under construction. Each function is built into
+     * its own FunSSA, which only reads the memory regions and the SVFIR, so that
+     * functions can be built in parallel; FunSSAs are then merged into MemSSA
+     * in the order of functions (see mergeFunSSA).
+     */
+    class FunSSA
+    {
+    public:
+        const SVFFunction* fun;
+
+        LoadToMUSetMap load2MuSetMap;
+        StoreToChiSetMap store2ChiSetMap;
+        CallSiteToMUSetMap callsiteToMuSetMap;
+        CallSiteToCHISetMap callsiteToChiSetMap;
+        BBToPhiSetMap bb2PhiSetMap;
+
+        FunToEntryChiSetMap funToEntryChiSetMap;
+        FunToReturnMuSetMap funToReturnMuSetMap;
+
+        MemRegToVerStackMap mr2VerStackMap;
+        /// Versions of memory regions are numbered per function
+        MemRegToCounterMap mr2CounterMap;
+
+        /// The following three set are used for prune SSA phi insertion
+        // (see algorithm in book Engineering A Compiler section 9.3)
+        ///@{
+        /// Collects used memory regions
+        MRSet usedRegs;
+        /// Maps memory region to its basic block
+        MemRegToBBsMap reg2BBMap;
+        /// Collect memory regions whose definition killed
+        MRSet varKills;
+        //@}
+
+        /// Versions created, in order, whose IDs are assigned when merged
+        std::vector<std::unique_ptr<MRVer>> mrVers;
+
+        /// Time of each step
+        //@{
+        double timeOfCreateMUCHI;
+        double timeOfInsertingPHI;
+        double timeOfSSARenaming;
+        //@}
+
+        FunSSA(const SVFFunction* f) : fun(f), timeOfCreateMUCHI(0), timeOfInsertingPHI(0), timeOfSSARenaming(0)
+        {
+        }
+
+        /// Get a new SSA name of a memory region
+        MRVer* newSSAName(const MemRegion* mr, MSSADEF* def);
+
+        /// Get the last version of the SSA ver of memory region
+        inline MRVer* getTopStackVer(const MemRegion* mr)
+        {
+            std::vector<MRVer*> &stack = mr2VerStackMap[mr];
+            assert(!stack.empty() && "stack is empty!!");
+            return stack.back();
+        }
+
+        /// Collect region uses and region defs according to mus/chis, in order to insert phis
+        //@{
+        inline void collectRegUses(const MemRegion* mr)
+        {
+            if (0 == varKills.count(mr))
+                usedRegs.insert(mr);
+        }
+        inline void collectRegDefs(const SVFBasicBlock* bb, const MemRegion* mr)
+        {
+            varKills.insert(mr);
+            reg2BBMap[mr].push_back(bb);
+        }
+        //@}
+
+        /// Add methods for mus/chis/phis
+        //@{
+        inline void AddLoadMU(const SVFBasicBlock* bb, const LoadStmt* load, const MRSet& mrSet)
+        {
+            for (MRSet::iterator iter = mrSet.begin(), eiter = mrSet.end(); iter != eiter; ++iter)
+                AddLoadMU(bb,load,*iter);
+        }
+        inline void AddStoreCHI(const SVFBasicBlock* bb, const StoreStmt* store, const MRSet& mrSet)
+        {
+            for (MRSet::iterator iter = mrSet.begin(), eiter = mrSet.end(); iter != eiter; ++iter)
+                AddStoreCHI(bb,store,*iter);
+        }
+        inline void AddCallSiteMU(const CallICFGNode* cs,  const MRSet& mrSet)
+        {
+            for (MRSet::iterator iter = mrSet.begin(), eiter = mrSet.end(); iter != eiter; ++iter)
+                AddCallSiteMU(cs,*iter);
+        }
+        inline void AddCallSiteCHI(const CallICFGNode* cs,  const MRSet& mrSet)
+        {
+            for (MRSet::iterator iter = mrSet.begin(), eiter = mrSet.end(); iter != eiter; ++iter)
+                AddCallSiteCHI(cs,*iter);
+        }
+        inline void AddMSSAPHI(const SVFBasicBlock* bb, const MRSet& mrSet)
+        {
+            for (MRSet::iterator iter = mrSet.begin(), eiter = mrSet.end(); iter != eiter; ++iter)
+                AddMSSAPHI(bb,*iter);
+        }
+        inline void AddLoadMU(const SVFBasicBlock* bb, const LoadStmt* load, const MemRegion* mr)
+        {
+            LOADMU* mu = new LOADMU(bb,load, mr);
+            load2MuSetMap[load].insert(mu);
+            collectRegUses(mr);
+        }
+        inline void AddStoreCHI(const SVFBasicBlock* bb, const StoreStmt* store, const MemRegion* mr)
+        {
+            STORECHI* chi = new STORECHI(bb,store, mr);
+            store2ChiSetMap[store].insert(chi);
+            collectRegUses(mr);
+            collectRegDefs(bb,mr);
+        }
+        inline void AddCallSiteMU(const CallICFGNode* cs, const MemRegion* mr)
+        {
+            CALLMU* mu = new CALLMU(cs, mr);
+            callsiteToMuSetMap[cs].insert(mu);
+            collectRegUses(mr);
+        }
+        inline void AddCallSiteCHI(const CallICFGNode* cs, const MemRegion* mr)
+        {
+            CALLCHI* chi = new CALLCHI(cs, mr);
+            callsiteToChiSetMap[cs].insert(chi);
+            collectRegUses(mr);
+            collectRegDefs(chi->getBasicBlock(),mr);
+        }
+        inline void AddMSSAPHI(const SVFBasicBlock* bb, const MemRegion* mr)
+        {
+            bb2PhiSetMap[bb].insert(new PHI(bb, mr));
+        }
+        //@}
+
+        /// Rename mus, chis and phis
+        //@{
+        /// Rename mu set
+        inline void RenameMuSet(const MUSet& muSet)
+        {
+            for (MUSet::const_iterator mit = muSet.begin(), emit = muSet.end();
+                    mit != emit; ++mit)
+            {
+                MU* mu = (*mit);
+                mu->setVer(getTopStackVer(mu->getMR()));
+            }
+        }
+
+        /// Rename chi set
+        inline void RenameChiSet(const CHISet& chiSet, MRVector& memRegs)
+        {
+            for (CHISet::const_iterator cit = chiSet.begin(), ecit = chiSet.end();
+                    cit != ecit; ++cit)
+            {
+                CHI* chi = (*cit);
+                chi->setOpVer(getTopStackVer(chi->getMR()));
+                chi->setResVer(newSSAName(chi->getMR(),chi));
+                memRegs.push_back(chi->getMR());
+            }
+        }
+
+        /// Rename result (LHS) of phis
+        inline void RenamePhiRes(const PHISet& phiSet, MRVector& memRegs)
+        {
+            for (PHISet::const_iterator iter = phiSet.begin(), eiter = phiSet.end();
+                    iter != eiter; ++iter)
+            {
+                PHI* phi = *iter;
+                phi->setResVer(newSSAName(phi->getMR(),phi));
+                memRegs.push_back(phi->getMR());
+            }
+        }
+
+        /// Rename operands (RHS) of phis
+        inline void RenamePhiOps(const PHISet& phiSet, u32_t pos, MRVector&)
+        {
+            for (PHISet::const_iterator iter = phiSet.begin(), eiter = phiSet.end();
+                    iter != eiter; ++iter)
+            {
+                PHI* phi = *iter;
+                phi->setOpVer(getTopStackVer(phi->getMR()), pos);
+            }
+        }
+        //@}
+    };
+
     BVDataPTAImpl* pta;
     MRGenerator* mrGen;
     MemSSAStat* stat;
 
+    /// Build the memory SSA of a function
+    virtual void buildFunSSA(FunSSA& ssa);
     /// Create mu chi for candidate regions in a function
-    virtual void createMUCHI(const SVFFunction& fun);
+    virtual void createMUCHI(FunSSA& ssa);
     /// Insert phi for candidate regions in a function
-    virtual void insertPHI(const SVFFunction& fun);
+    virtual void insertPHI(FunSSA& ssa);
     /// SSA rename for a function
-    virtual void SSARename(const SVFFunction& fun);
+    virtual void SSARename(FunSSA& ssa);
     /// SSA rename for a basic block
-    virtual void SSARenameBB(const SVFBasicBlock& bb);
+    virtual void SSARenameBB(const SVFBasicBlock& bb, FunSSA& ssa);
+    /// Move the mus/chis/phis of a function into MemSSA, and number its versions
+    void mergeFunSSA(FunSSA& ssa);
 private:
     LoadToMUSetMap load2MuSetMap;
     StoreToChiSetMap store2ChiSetMap;
@@ -140,159 +339,11 @@ private:
     FunToEntryChiSetMap funToEntryChiSetMap;
     FunToReturnMuSetMap funToReturnMuSetMap;
 
-    MemRegToVerStackMap mr2VerStackMap;
-    MemRegToCounterMap mr2CounterMap;
-
-    /// The following three set are used for prune SSA phi insertion
-    // (see algorithm in book Engineering A Compiler section 9.3)
-    ///@{
-    /// Collects used memory regions
-    MRSet usedRegs;
-    /// Maps memory region to its basic block
-    MemRegToBBsMap reg2BBMap;
-    /// Collect memory regions whose definition killed
-    MRSet varKills;
-    //@}
-
     std::vector<std::unique_ptr<MRVer>> usedMRVers;
 
     /// Release the memory
     void destroy();
 
-    /// Get a new SSA name of a memory region
-    MRVer* newSSAName(const MemRegion* mr, MSSADEF* def);
-
-    /// Get the last version of the SSA ver of memory region
-    inline MRVer* getTopStackVer(const MemRegion* mr)
-    {
-        std::vector<MRVer*> &stack = mr2VerStackMap[mr];
-        assert(!stack.empty() && "stack is empty!!");
-        return stack.back();
-    }
-
-    /// Collect region uses and region defs according to mus/chis, in order to insert phis
-    //@{
-    inline void collectRegUses(const MemRegion* mr)
-    {
-        if (0 == varKills.count(mr))
-            usedRegs.insert(mr);
-    }
-    inline void collectRegDefs(const SVFBasicBlock* bb, const MemRegion* mr)
-    {
-        varKills.insert(mr);
-        reg2BBMap[mr].push_back(bb);
-    }
-    //@}
-
-    /// Add methods for mus/chis/phis
-    //@{
-    inline void AddLoadMU(const SVFBasicBlock* bb, const LoadStmt* load, const MRSet& mrSet)
-    {
-        for (MRSet::iterator iter = mrSet.begin(), eiter = mrSet.end(); iter != eiter; ++iter)
-            AddLoadMU(bb,load,*iter);
-    }
-    inline void AddStoreCHI(const SVFBasicBlock* bb, const StoreStmt* store, const MRSet& mrSet)
-    {
-        for (MRSet::iterator iter = mrSet.begin(), eiter = mrSet.end(); iter != eiter; ++iter)
-            AddStoreCHI(bb,store,*iter);
-    }
-    inline void AddCallSiteMU(const CallICFGNode* cs,  const MRSet& mrSet)
-    {
-        for (MRSet::iterator iter = mrSet.begin(), eiter = mrSet.end(); iter != eiter; ++iter)
-            AddCallSiteMU(cs,*iter);
-    }
-    inline void AddCallSiteCHI(const CallICFGNode* cs,  const MRSet& mrSet)
-    {
-        for (MRSet::iterator iter = mrSet.begin(), eiter = mrSet.end(); iter != eiter; ++iter)
-            AddCallSiteCHI(cs,*iter);
-    }
-    inline void AddMSSAPHI(const SVFBasicBlock* bb, const MRSet& mrSet)
-    {
-        for (MRSet::iterator iter = mrSet.begin(), eiter = mrSet.end(); iter != eiter; ++iter)
-            AddMSSAPHI(bb,*iter);
-    }
-    inline void AddLoadMU(const SVFBasicBlock* bb, const LoadStmt* load, const MemRegion* mr)
-    {
-        LOADMU* mu = new LOADMU(bb,load, mr);
-        load2MuSetMap[load].insert(mu);
-        collectRegUses(mr);
-    }
-    inline void AddStoreCHI(const SVFBasicBlock* bb, const StoreStmt* store, const MemRegion* mr)
-    {
-        STORECHI* chi = new STORECHI(bb,store, mr);
-        store2ChiSetMap[store].insert(chi);
-        collectRegUses(mr);
-        collectRegDefs(bb,mr);
-    }
-    inline void AddCallSiteMU(const CallICFGNode* cs, const MemRegion* mr)
-    {
-        CALLMU* mu = new CALLMU(cs, mr);
-        callsiteToMuSetMap[cs].insert(mu);
-        collectRegUses(mr);
-    }
-    inline void AddCallSiteCHI(const CallICFGNode* cs, const MemRegion* mr)
-    {
-        CALLCHI* chi = new CALLCHI(cs, mr);
-        callsiteToChiSetMap[cs].insert(chi);
-        collectRegUses(mr);
-        collectRegDefs(chi->getBasicBlock(),mr);
-    }
-    inline void AddMSSAPHI(const SVFBasicBlock* bb, const MemRegion* mr)
-    {
-        bb2PhiSetMap[bb].insert(new PHI(bb, mr));
-    }
-    //@}
-
-    /// Rename mus, chis and phis
-    //@{
-    /// Rename mu set
-    inline void RenameMuSet(const MUSet& muSet)
-    {
-        for (MUSet::const_iterator mit = muSet.begin(), emit = muSet.end();
-                mit != emit; ++mit)
-        {
-            MU* mu = (*mit);
-            mu->setVer(getTopStackVer(mu->getMR()));
-        }
-    }
-
-    /// Rename chi set
-    inline void RenameChiSet(const CHISet& chiSet, MRVector& memRegs)
-    {
-        for (CHISet::const_iterator cit = chiSet.begin(), ecit = chiSet.end();
-                cit != ecit; ++cit)
-        {
-            CHI* chi = (*cit);
-            chi->setOpVer(getTopStackVer(chi->getMR()));
-            chi->setResVer(newSSAName(chi->getMR(),chi));
-            memRegs.push_back(chi->getMR());
-        }
-    }
-
-    /// Rename result (LHS) of phis
-    inline void RenamePhiRes(const PHISet& phiSet, MRVector& memRegs)
-    {
-        for (PHISet::const_iterator iter = phiSet.begin(), eiter = phiSet.end();
-                iter != eiter; ++iter)
-        {
-            PHI* phi = *iter;
-            phi->setResVer(newSSAName(phi->getMR(),phi));
-            memRegs.push_back(phi->getMR());
-        }
-    }
-
-    /// Rename operands (RHS) of phis
-    inline void RenamePhiOps(const PHISet& phiSet, u32_t pos, MRVector&)
-    {
-        for (PHISet::const_iterator iter = phiSet.begin(), eiter = phiSet.end();
-                iter != eiter; ++iter)
-        {
-            PHI* phi = *iter;
-            phi->setOpVer(getTopStackVer(phi->getMR()), pos);
-        }
-    }
-    //@}
-
 public:
     /// Constructor
     MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA);
@@ -316,6 +367,9 @@ public:
     }
     /// We start from here
     virtual void buildMemSSA(const SVFFunction& fun);
+    /// Build memory SSA for functions on Options::MSSAThreads() threads; the
+    /// result does not depend on the number of threads
+    void buildMemSSA(const std::vector<const SVFFunction*>& funs);
 
     /// Perform statistics
     void performStat();
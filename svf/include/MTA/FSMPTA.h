@@ -106,6 +106,7 @@ public:
     typedef NodeBS SVFGNodeIDSet;
     typedef Set<const SVFInstruction*> InstSet;
     typedef std::pair<NodeID,NodeID> NodeIDPair;
+    typedef std::pair<const StmtSVFGNode*, const StmtSVFGNode*> StmtNodePair;
     typedef Map<SVFGNodeLockSpan, bool> PairToBoolMap;
 
     /// Constructor
@@ -136,12 +137,21 @@ private:
     SVFGEdge* addTDEdges(NodeID srcId, NodeID dstId, PointsTo& pts);
     /// Connect MHP indirect value-flow edges for two nodes that may-happen-in-parallel
     void connectMHPEdges(PointerAnalysis* pta);
+    /// Only pair stores and loads which may access a common abstract object
+    void connectMHPEdgesByObjects(BVDataPTAImpl* pta);
+    /// Keep the pairs which may happen in parallel, checked by Options::TDEdgeThreads() threads
+    void filterMHPPairs(std::vector<StmtNodePair>& pairs);
 
     void handleStoreLoadNonSparse(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta);
     void handleStoreStoreNonSparse(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta);
 
     void handleStoreLoad(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta);
     void handleStoreStore(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta);
+    /// Lock check and edge adding of a store/load (store/store) pair which may happen in parallel and may alias
+    //@{
+    void addStoreLoadEdges(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta);
+    void addStoreStoreEdges(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta);
+    //@}
 
     void handleStoreLoadWithLockPrecisely(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta);
     void handleStoreStoreWithLockPrecisely(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta);
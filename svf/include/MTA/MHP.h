@@ -108,6 +108,15 @@ public:
     virtual bool mayHappenInParallelCache(const SVFInstruction* i1, const SVFInstruction* i2);
     virtual bool mayHappenInParallelInst(const SVFInstruction* i1, const SVFInstruction* i2);
     virtual bool executedByTheSameThread(const SVFInstruction* i1, const SVFInstruction* i2);
+    /// Read-only variant of mayHappenInParallelInst, safe to call from several threads.
+    /// It neither caches results nor updates query statistics (see recordQueries).
+    bool mayHappenInParallelInstReadOnly(const SVFInstruction* i1, const SVFInstruction* i2) const;
+    /// Account for numOfQueries queries answered outside mayHappenInParallel, numOfMHP of them positively
+    inline void recordQueries(u32_t numOfQueries, u32_t numOfMHP)
+    {
+        numOfTotalQueries += numOfQueries;
+        numOfMHPQueries += numOfMHP;
+    }
 
     /// Get interleaving thread for statement inst
     //@{
@@ -16,6 +16,7 @@
 
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <vector>
 #include <functional>
 
@@ -34,14 +35,112 @@ class PersistentPointsToCache
 public:
     typedef Map<Data, PointsToID> PTSToIDMap;
     typedef std::function<Data(const Data &, const Data &)> DataOp;
-    // TODO: an unordered pair type may be better.
-    typedef Map<std::pair<PointsToID, PointsToID>, PointsToID> OpCache;
+
+    /// Memoized results of one operation, optionally bounded in size.
+    /// Entries live in two generations. A hit in the old generation is promoted to the young
+    /// one, and once the young generation holds half the limit the old generation is dropped
+    /// wholesale and the young one takes its place. This approximates LRU eviction without
+    /// any per-entry bookkeeping. A limit of 0 means unbounded.
+    class OpCache
+    {
+    public:
+        // TODO: an unordered pair type may be better.
+        typedef std::pair<PointsToID, PointsToID> Operands;
+        typedef Map<Operands, PointsToID> OpMap;
+
+        OpCache(void) : limit(0), evictions(0) { }
+
+        /// Returns true and sets result if the operation on operands is cached.
+        inline bool find(const Operands &operands, PointsToID &result)
+        {
+            typename OpMap::const_iterator foundResult = young.find(operands);
+            if (foundResult != young.end())
+            {
+                result = foundResult->second;
+                return true;
+            }
+
+            foundResult = old.find(operands);
+            if (foundResult == old.end()) return false;
+
+            result = foundResult->second;
+            insert(operands, result);
+            return true;
+        }
+
+        inline void insert(const Operands &operands, PointsToID result)
+        {
+            young[operands] = result;
+            if (limit != 0 && young.size() >= std::max<size_t>(limit / 2, 1))
+            {
+                evictions += old.size();
+                old = std::move(young);
+                young.clear();
+            }
+        }
+
+        /// Rewrites cached operations to new IDs, dropping those involving dead IDs.
+        void remap(const std::vector<PointsToID> &newIds)
+        {
+            young = remapped(young, newIds);
+            old = remapped(old, newIds);
+        }
+
+        inline void clear(void)
+        {
+            young.clear();
+            old.clear();
+        }
+
+        inline size_t size(void) const
+        {
+            return young.size() + old.size();
+        }
+
+        inline void setLimit(size_t l)
+        {
+            limit = l;
+        }
+
+        inline u64_t getEvictions(void) const
+        {
+            return evictions;
+        }
+
+    private:
+        static OpMap remapped(const OpMap &opMap, const std::vector<PointsToID> &newIds)
+        {
+            OpMap remappedMap;
+            for (const typename OpMap::value_type &op : opMap)
+            {
+                const PointsToID lhs = newIds[op.first.first];
+                const PointsToID rhs = newIds[op.first.second];
+                const PointsToID result = newIds[op.second];
+                if (lhs == invalidPointsToId() || rhs == invalidPointsToId() || result == invalidPointsToId()) continue;
+                // Renumbering keeps the relative order of IDs, so sorted keys stay sorted.
+                remappedMap[std::make_pair(lhs, rhs)] = result;
+            }
+
+            return remappedMap;
+        }
+
+        OpMap young;
+        OpMap old;
+        size_t limit;
+        u64_t evictions;
+    };
 
     static PointsToID emptyPointsToId(void)
     {
         return 0;
     };
 
+    /// ID which collectGarbage maps dead points-to sets to.
+    static PointsToID invalidPointsToId(void)
+    {
+        return std::numeric_limits<PointsToID>::max();
+    };
+
 public:
     PersistentPointsToCache(void) : idCounter(1)
     {
@@ -102,6 +201,61 @@ public:
         return id;
     }
 
+    /// Number of points-to sets stored, dead or alive.
+    inline size_t getNumPts(void) const
+    {
+        return idToPts.size();
+    }
+
+    /// Bounds the number of entries each operation cache keeps (0 means unbounded).
+    void setOpCacheLimit(size_t limit)
+    {
+        unionCache.setLimit(limit);
+        complementCache.setLimit(limit);
+        intersectionCache.setLimit(limit);
+    }
+
+    /// Frees every points-to set whose ID is not marked in live (the empty set is always kept)
+    /// and renumbers the remaining ones densely, keeping their relative order.
+    /// The cache only knows sets, not who refers to them, so live must be filled in by the
+    /// PTDatas, which in turn must rewrite the IDs they hold with the returned mapping from
+    /// old to new IDs. Dead IDs are mapped to invalidPointsToId().
+    std::vector<PointsToID> collectGarbage(const std::vector<bool> &live)
+    {
+        std::vector<PointsToID> newIds(idToPts.size(), invalidPointsToId());
+        PointsToID nextId = 0;
+        for (PointsToID id = 0; id < idToPts.size(); ++id)
+        {
+            if (id != emptyPointsToId() && (id >= live.size() || !live[id])) continue;
+
+            newIds[id] = nextId;
+            if (nextId != id) idToPts[nextId] = std::move(idToPts[id]);
+            ++nextId;
+        }
+
+        ++collections;
+        collectedPts += idToPts.size() - nextId;
+        idToPts.resize(nextId);
+        idCounter = nextId;
+
+        for (typename PTSToIDMap::iterator it = ptsToId.begin(); it != ptsToId.end();)
+        {
+            const PointsToID newId = newIds[it->second];
+            if (newId == invalidPointsToId()) it = ptsToId.erase(it);
+            else
+            {
+                it->second = newId;
+                ++it;
+            }
+        }
+
+        unionCache.remap(newIds);
+        complementCache.remap(newIds);
+        intersectionCache.remap(newIds);
+
+        return newIds;
+    }
+
     /// Returns the points-to set which id represents. id must be stored in the cache.
     const Data &getActualPts(PointsToID id) const
     {
@@ -151,7 +305,7 @@ public:
             // if x U y = z, then x U z = z,
             if (lhs != result)
             {
-                unionCache[std::minmax(lhs, result)] = result;
+                unionCache.insert(std::minmax(lhs, result), result);
                 ++preemptiveUnions;
                 ++totalUnions;
             }
@@ -159,7 +313,7 @@ public:
             // and y U z = z.
             if (rhs != result)
             {
-                unionCache[std::minmax(rhs, result)] = result;
+                unionCache.insert(std::minmax(rhs, result), result);
                 ++preemptiveUnions;
                 ++totalUnions;
             }
@@ -212,17 +366,17 @@ public:
             if (result != emptyPointsToId())
             {
                 // result AND rhs = EMPTY_SET,
-                intersectionCache[std::minmax(result, rhs)] = emptyPointsToId();
+                intersectionCache.insert(std::minmax(result, rhs), emptyPointsToId());
                 ++preemptiveIntersections;
                 ++totalIntersections;
 
                 // and result AND lhs = result,
-                intersectionCache[std::minmax(result, lhs)] = result;
+                intersectionCache.insert(std::minmax(result, lhs), result);
                 ++preemptiveIntersections;
                 ++totalIntersections;
 
                 // and result - rhs = result.
-                complementCache[std::make_pair(result, rhs)] = result;
+                complementCache.insert(std::make_pair(result, rhs), result);
                 ++preemptiveComplements;
                 ++totalComplements;
             }
@@ -273,7 +427,7 @@ public:
                 // result AND rhs = result,
                 if (result != rhs)
                 {
-                    intersectionCache[std::minmax(result, rhs)] = result;
+                    intersectionCache.insert(std::minmax(result, rhs), result);
                     ++preemptiveIntersections;
                     ++totalIntersections;
                 }
@@ -281,7 +435,7 @@ public:
                 // and result AND lhs = result,
                 if (result != lhs)
                 {
-                    intersectionCache[std::minmax(result, lhs)] = result;
+                    intersectionCache.insert(std::minmax(result, lhs), result);
                     ++preemptiveIntersections;
                     ++totalIntersections;
                 }
@@ -290,7 +444,7 @@ public:
                 // result U lhs = result,
                 if (result != emptyPointsToId() && result != lhs)
                 {
-                    unionCache[std::minmax(lhs, result)] = lhs;
+                    unionCache.insert(std::minmax(lhs, result), lhs);
                     ++preemptiveUnions;
                     ++totalUnions;
                 }
@@ -298,7 +452,7 @@ public:
                 // And result U rhs = rhs.
                 if (result != emptyPointsToId() && result != rhs)
                 {
-                    unionCache[std::minmax(rhs, result)] = rhs;
+                    unionCache.insert(std::minmax(rhs, result), rhs);
                     ++preemptiveUnions;
                     ++totalUnions;
                 }
@@ -335,6 +489,11 @@ public:
         SVFUtil::outs() << std::setw(fieldWidth) << "LookupIntersections"     << lookupIntersections     << "\n";
         SVFUtil::outs() << std::setw(fieldWidth) << "PreemptiveIntersections" << preemptiveIntersections << "\n";
 
+        SVFUtil::outs() << std::setw(fieldWidth) << "GarbageCollections"      << collections             << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "CollectedPointsToSets"   << collectedPts            << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "EvictedOpCacheEntries"
+                        << unionCache.getEvictions() + complementCache.getEvictions() + intersectionCache.getEvictions() << "\n";
+
         SVFUtil::outs().flush();
     }
 
@@ -349,8 +508,6 @@ public:
         return allPts;
     }
 
-    // TODO: ref count API for garbage collection.
-
 private:
     PointsToID newPointsToId(void)
     {
@@ -372,8 +529,8 @@ private:
         else operands = std::make_pair(lhs, rhs);
 
         // Check if we have performed this operation
-        OpCache::const_iterator foundResult = opCache.find(operands);
-        if (foundResult != opCache.end()) return foundResult->second;
+        PointsToID cachedResult;
+        if (opCache.find(operands, cachedResult)) return cachedResult;
 
         opPerformed = true;
 
@@ -394,7 +551,7 @@ private:
         }
 
         // Cache the result, for hash-consing.
-        opCache[operands] = resultId;
+        opCache.insert(operands, resultId);
 
         return resultId;
     }
@@ -418,6 +575,8 @@ private:
         propertyIntersections    = 0;
         lookupIntersections      = 0;
         preemptiveIntersections  = 0;
+        collections              = 0;
+        collectedPts             = 0;
     }
 
 private:
@@ -440,6 +599,10 @@ private:
     /// Used to generate new PointsToIDs. Any non-zero is valid.
     PointsToID idCounter;
 
+    /// Garbage collection statistics.
+    u64_t collections;
+    u64_t collectedPts;
+
     // Statistics:
     u64_t totalUnions;
     u64_t uniqueUnions;
@@ -117,6 +117,14 @@ public:
         ptCache.remapAllPts();
     }
 
+    /// Calls f on a reference to every points-to ID held, so that garbage collection of the
+    /// cache can mark live IDs and rewrite them once renumbered.
+    template <typename F>
+    void visitPtsIds(F f)
+    {
+        for (typename KeyToIDMap::value_type &ki : ptsMap) f(ki.second);
+    }
+
     Map<DataSet, unsigned> getAllPts(bool liveOnly) const override
     {
         Map<DataSet, unsigned> allPts;
@@ -262,6 +270,15 @@ public:
         ptCache.remapAllPts();
     }
 
+    /// Calls f on a reference to every points-to ID held (see PersistentPTData::visitPtsIds).
+    template <typename F>
+    void visitPtsIds(F f)
+    {
+        persPTData.visitPtsIds(f);
+        for (typename KeyToIDMap::value_type &ki : diffPtsMap) f(ki.second);
+        for (typename KeyToIDMap::value_type &ki : propaPtsMap) f(ki.second);
+    }
+
     inline void dumpPTData() override
     {
         // TODO.
@@ -396,6 +413,22 @@ public:
         ptCache.remapAllPts();
     }
 
+    /// Calls f on a reference to every points-to ID held (see PersistentPTData::visitPtsIds).
+    template <typename F>
+    void visitPtsIds(F f)
+    {
+        persPTData.visitPtsIds(f);
+        for (typename DFKeyToIDMap::value_type &lki : dfInPtsMap)
+        {
+            for (typename KeyToIDMap::value_type &ki : lki.second) f(ki.second);
+        }
+
+        for (typename DFKeyToIDMap::value_type &lki : dfOutPtsMap)
+        {
+            for (typename KeyToIDMap::value_type &ki : lki.second) f(ki.second);
+        }
+    }
+
     inline void dumpPTData() override
     {
         persPTData.dumpPTData();
@@ -901,6 +934,14 @@ public:
         tlPTData.remapAllPts();
     }
 
+    /// Calls f on a reference to every points-to ID held (see PersistentPTData::visitPtsIds).
+    template <typename F>
+    void visitPtsIds(F f)
+    {
+        tlPTData.visitPtsIds(f);
+        atPTData.visitPtsIds(f);
+    }
+
     Map<DataSet, unsigned> getAllPts(bool liveOnly) const override
     {
         // Explicitly pass in true because if we call it with false,
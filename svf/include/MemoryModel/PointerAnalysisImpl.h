@@ -138,6 +138,18 @@ public:
     /// Remap all points-to sets to use the current mapping.
     void remapPointsToSets(void);
 
+    /// Garbage collection of the persistent points-to cache.
+    /// Must only be called when no points-to IDs are held outside the PTData, e.g., between
+    /// processing two nodes of a solver.
+    //@{
+    inline void collectPtsGarbageIfNeeded(void)
+    {
+        if (nextPtsGC != 0 && ptCache.getNumPts() >= nextPtsGC)
+            collectPtsGarbage();
+    }
+    void collectPtsGarbage(void);
+    //@}
+
     /// Interface for analysis result storage on filesystem.
     //@{
     virtual void writeToFile(const std::string& filename);
@@ -150,6 +162,14 @@ public:
     virtual void readAndSetObjFieldSensitivity(std::ifstream& f, const std::string& delimiterStr);
     //@}
 
+    /// Binary, memory-mappable storage of analysis results.
+    /// readFromFile detects this format by its header and forwards to readFromBinaryFile.
+    //@{
+    virtual void writeToBinaryFile(const std::string& filename);
+    virtual bool readFromBinaryFile(const std::string& filename);
+    static bool isBinaryPtsFile(const std::string& filename);
+    //@}
+
 protected:
     /// Get points-to data structure
     inline PTDataTy* getPTDataTy() const
@@ -209,6 +229,9 @@ private:
 
     PersistentPointsToCache<PointsTo> ptCache;
 
+    /// Size of ptCache at which to collect garbage next (0 if collection is disabled).
+    size_t nextPtsGC;
+
 public:
     /// Interface expose to users of our pointer analysis, given Value infos
     AliasResult alias(const SVFValue* V1,
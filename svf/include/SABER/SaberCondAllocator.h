@@ -298,7 +298,7 @@ private:
     IndexToTermInstMap idToTermInstMap;     ///key: z3 expression id, value: instruction
     NodeBS negConds;                        ///bit vector for distinguish neg
     std::vector<Condition> conditionVec;          /// vector storing z3expression
-    static u32_t totalCondNum; /// a counter for fresh condition
+    static thread_local u32_t totalCondNum; /// a counter for fresh condition (per thread, as is the z3 context)
 
 protected:
     BBCondMap bbConds;						///< map basic block to its successors/predecessors branch conditions
@@ -66,12 +66,38 @@ public:
     typedef ProgSlice::VFWorkList WorkList;
 
 private:
-    ProgSlice* _curSlice;		/// current program slice
+    /// State for analysing one source at a time, owned by each thread checking sources
+    struct SliceWorker
+    {
+        ProgSlice* curSlice;		/// current program slice
+        std::unique_ptr<SaberCondAllocator> saberCondAllocator;
+        SVFGNodeToDPItemsMap nodeToDPItemsMap;	///<  record forward visited dpitems
+        SVFGNodeSet visitedSet;	///<  record backward visited nodes
+        CFLSrcSnkSolver::WorkList worklist;	///< worklist for slicing
+
+        SliceWorker() : curSlice(nullptr), saberCondAllocator(std::make_unique<SaberCondAllocator>())
+        {
+        }
+        ~SliceWorker()
+        {
+            delete curSlice;
+            curSlice = nullptr;
+        }
+    };
+
     SVFGNodeSet sources;		/// source nodes
     SVFGNodeSet sinks;		/// source nodes
-    std::unique_ptr<SaberCondAllocator> saberCondAllocator;
-    SVFGNodeToDPItemsMap nodeToDPItemsMap;	///<  record forward visited dpitems
-    SVFGNodeSet visitedSet;	///<  record backward visited nodes
+    SliceWorker mainWorker;	///< state of the sequential analysis
+    static thread_local SliceWorker* threadWorker;	///< state of the current thread when checking in parallel
+
+    inline SliceWorker& worker()
+    {
+        return threadWorker ? *threadWorker : mainWorker;
+    }
+    inline const SliceWorker& worker() const
+    {
+        return threadWorker ? *threadWorker : mainWorker;
+    }
 
 protected:
     SaberSVFGBuilder memSSA;
@@ -82,18 +108,14 @@ protected:
 public:
 
     /// Constructor
-    SrcSnkDDA() : _curSlice(nullptr), svfg(nullptr), ptaCallGraph(nullptr)
+    SrcSnkDDA() : svfg(nullptr), ptaCallGraph(nullptr)
     {
-        saberCondAllocator = std::make_unique<SaberCondAllocator>();
     }
     /// Destructor
     ~SrcSnkDDA() override
     {
         svfg = nullptr;
 
-        delete _curSlice;
-        _curSlice = nullptr;
-
         /// the following shared by multiple checkers, thus can not be released.
         //if (ptaCallGraph != nullptr)
         //    delete ptaCallGraph;
@@ -107,6 +129,9 @@ public:
     /// Start analysis here
     virtual void analyze(SVFModule* module);
 
+    /// Compute the slice of a source and its guards (the bug is reported separately)
+    virtual void analyzeSource(const SVFGNode* src);
+
     /// Initialize analysis
     virtual void initialize(SVFModule* module);
 
@@ -145,28 +170,28 @@ public:
 
     inline ProgSlice* getCurSlice() const
     {
-        return _curSlice;
+        return worker().curSlice;
     }
     inline void addSinkToCurSlice(const SVFGNode* node)
     {
-        _curSlice->addToSinks(node);
+        getCurSlice()->addToSinks(node);
         addToCurForwardSlice(node);
     }
     inline bool isInCurForwardSlice(const SVFGNode* node)
     {
-        return _curSlice->inForwardSlice(node);
+        return getCurSlice()->inForwardSlice(node);
     }
     inline bool isInCurBackwardSlice(const SVFGNode* node)
     {
-        return _curSlice->inBackwardSlice(node);
+        return getCurSlice()->inBackwardSlice(node);
     }
     inline void addToCurForwardSlice(const SVFGNode* node)
     {
-        _curSlice->addToForwardSlice(node);
+        getCurSlice()->addToForwardSlice(node);
     }
     inline void addToCurBackwardSlice(const SVFGNode* node)
     {
-        _curSlice->addToBackwardSlice(node);
+        getCurSlice()->addToBackwardSlice(node);
     }
     //@}
 
@@ -240,7 +265,7 @@ public:
     /// Get saber condition allocator
     SaberCondAllocator* getSaberCondAllocator() const
     {
-        return saberCondAllocator.get();
+        return worker().saberCondAllocator.get();
     }
 
     inline const SVFBugReport& getBugReport() const
@@ -256,7 +281,7 @@ protected:
         if(isSink(node))
         {
             addSinkToCurSlice(node);
-            _curSlice->setPartialReachable();
+            getCurSlice()->setPartialReachable();
         }
         else
             addToCurForwardSlice(node);
@@ -278,6 +303,7 @@ protected:
     //@{
     inline bool forwardVisited(const SVFGNode* node, const DPIm& item)
     {
+        const SVFGNodeToDPItemsMap& nodeToDPItemsMap = worker().nodeToDPItemsMap;
         SVFGNodeToDPItemsMap::const_iterator it = nodeToDPItemsMap.find(node);
         if(it!=nodeToDPItemsMap.end())
             return it->second.find(item)!=it->second.end();
@@ -286,33 +312,42 @@ protected:
     }
     inline void addForwardVisited(const SVFGNode* node, const DPIm& item)
     {
-        nodeToDPItemsMap[node].insert(item);
+        worker().nodeToDPItemsMap[node].insert(item);
     }
     inline bool backwardVisited(const SVFGNode* node)
     {
+        const SVFGNodeSet& visitedSet = worker().visitedSet;
         return visitedSet.find(node)!=visitedSet.end();
     }
     inline void addBackwardVisited(const SVFGNode* node)
     {
-        visitedSet.insert(node);
+        worker().visitedSet.insert(node);
     }
     inline void clearVisitedMap()
     {
-        nodeToDPItemsMap.clear();
-        visitedSet.clear();
+        worker().nodeToDPItemsMap.clear();
+        worker().visitedSet.clear();
+    }
+    /// Worklist of the slice being computed by the current thread
+    inline CFLSrcSnkSolver::WorkList& getWorklist() override
+    {
+        return worker().worklist;
     }
     //@}
 
     /// Whether it is all path reachable from a source
     virtual bool isAllPathReachable()
     {
-        return _curSlice->isAllReachable();
+        return getCurSlice()->isAllReachable();
     }
     /// Whether it is some path reachable from a source
     virtual bool isSomePathReachable()
     {
-        return _curSlice->isPartialReachable();
+        return getCurSlice()->isPartialReachable();
     }
+    /// Check sources on Options::SaberThreads() threads, reporting bugs in source order
+    void analyzeInParallel();
+
     /// Dump SVFG with annotated slice information
     //@{
     void dumpSlices();
@@ -72,7 +72,8 @@
     {                                                                          \
         ABORT_IFNOT(jsonKeyEquals(json, name),                                 \
                     "Expect name '" << name << "', got " << JSON_KEY(json));   \
-        SVFIRReader::readJson(json, obj);                                      \
+        LazyJson lazyJson(json);                                               \
+        SVFIRReader::readJson(lazyJson.get(), obj);                            \
     } while (0)
 
 #define JSON_READ_OBJ_WITH_NAME_FWD(json, obj, name)                           \
@@ -208,6 +209,10 @@ bool jsonIsMap(const cJSON* item);
 bool jsonIsObject(const cJSON* item);
 bool jsonKeyEquals(const cJSON* item, const char* key);
 std::pair<const cJSON*, const cJSON*> jsonUnpackPair(const cJSON* item);
+/// @brief Number of fields from first up to (not including) rest.
+u32_t jsonCountFields(const cJSON* first, const cJSON* rest);
+/// @brief The field n fields after first.
+const cJSON* jsonSkipFields(const cJSON* first, u32_t n);
 double jsonGetNumber(const cJSON* item);
 cJSON* jsonCreateNullId();
 cJSON* jsonCreateObject();
@@ -226,6 +231,69 @@ bool jsonAddStringToObject(cJSON* obj, const char* name, const std::string& s);
 #define jsonForEach(field, array)                                              \
     for (const cJSON* field = JSON_CHILD(array); field; field = field->next)
 
+/// @brief A JSON value which may not have been parsed yet.
+/// SVFIRReader::read(path) only parses the outline of the file (the SVFIR and
+/// its parts), and keeps the elements of their fields (nodes, edges, values,
+/// map entries...) as references to their text. A LazyJson parses such an
+/// element on construction and frees it on destruction, so that only one
+/// element is in memory at a time. Parsed values are passed through.
+class LazyJson
+{
+private:
+    const cJSON* item;
+    cJSON* parsed;
+
+public:
+    explicit LazyJson(const cJSON* item);
+    LazyJson(const LazyJson&) = delete;
+    LazyJson& operator=(const LazyJson&) = delete;
+    ~LazyJson()
+    {
+        cJSON_Delete(parsed);
+    }
+
+    inline const cJSON* get() const
+    {
+        return parsed ? parsed : item;
+    }
+
+    /// @brief Create an unparsed value referring to text (which must outlive it).
+    static cJSON* create(const char* text, size_t length);
+    static bool isLazy(const cJSON* item);
+};
+
+/// @brief Writes JSON to a stream as it is produced. Objects and arrays are
+/// opened and closed explicitly, and their members are written one by one
+/// (as cJSON items, freed once written), so that the whole document never has
+/// to be in memory. The output is the same as printing the document with
+/// cJSON, which also means that objects are written as arrays without keys
+/// when the JSON is not human-readable (see jsonCreateObject()).
+class JsonStreamWriter
+{
+private:
+    std::ostream& os;
+    const bool humanReadable;
+    /// Open objects/arrays: (is object, has members)
+    std::vector<std::pair<bool, bool>> scopes;
+
+public:
+    JsonStreamWriter(std::ostream& os, bool humanReadable);
+
+    /// name is the key of the new object/array or item in the enclosing object.
+    ///@{
+    void beginObject(const char* name = nullptr);
+    void endObject();
+    void beginArray(const char* name = nullptr);
+    void endArray();
+    void writeItem(const char* name, cJSON* item);
+    ///@}
+
+private:
+    void beginMember(const char* name);
+    void endScope(char close);
+    void writeTabs(size_t depth);
+};
+
 /// @brief Bookkeeping class to keep track of the IDs of objects that doesn't
 /// have any ID. E.g., SVFValue, XXXEdge.
 /// @tparam T
@@ -399,25 +467,31 @@ public:
     static void writeJsonToPath(const SVFIR* svfir, const std::string& path);
 
 private:
-    /// @brief Main logic to dump a SVFIR to a JSON object.
-    autoJSON generateJson();
-    autoCStr generateJsonString();
+    /// @brief Main logic to dump a SVFIR as JSON. The large parts of the SVFIR
+    /// are streamed element by element instead of being built as a cJSON tree.
+    void writeJson(JsonStreamWriter& writer);
 
     const char* numToStr(size_t n);
 
     cJSON* toJson(const NodeIDAllocator* nodeIDAllocator);
-    cJSON* toJson(const SymbolTableInfo* symTable);
-    cJSON* toJson(const SVFModule* module);
+    void writeJson(JsonStreamWriter& writer, const char* name,
+                   const SymbolTableInfo* symTable);
+    void writeJson(JsonStreamWriter& writer, const char* name,
+                   const SVFModule* module);
+    void writeJson(JsonStreamWriter& writer, const char* name,
+                   const IRGraph* graph); // IRGraph Graph
+    void writeJson(JsonStreamWriter& writer, const char* name,
+                   const ICFG* icfg); // ICFG Graph
+    void writeJson(JsonStreamWriter& writer, const char* name,
+                   const CommonCHGraph* graph); // CHGraph Graph
+    void writeJson(JsonStreamWriter& writer, const char* name,
+                   const CHGraph* graph); // CHGraph Graph
     cJSON* toJson(const SVFType* type);
     cJSON* toJson(const SVFValue* value);
-    cJSON* toJson(const IRGraph* graph);       // IRGraph Graph
     cJSON* toJson(const SVFVar* var);          // IRGraph Node
     cJSON* toJson(const SVFStmt* stmt);        // IRGraph Edge
-    cJSON* toJson(const ICFG* icfg);           // ICFG Graph
     cJSON* toJson(const ICFGNode* node);       // ICFG Node
     cJSON* toJson(const ICFGEdge* edge);       // ICFG Edge
-    cJSON* toJson(const CommonCHGraph* graph); // CHGraph Graph
-    cJSON* toJson(const CHGraph* graph);       // CHGraph Graph
     cJSON* toJson(const CHNode* node);         // CHGraph Node
     cJSON* toJson(const CHEdge* edge);         // CHGraph Edge
 
@@ -556,33 +630,28 @@ private:
         return root;
     }
 
+    /// Write the nodes and edges of a graph into the object being written.
     template <typename NodeTy, typename EdgeTy>
-    cJSON* genericGraphToJson(const GenericGraph<NodeTy, EdgeTy>* graph,
-                              const std::vector<const EdgeTy*>& edgePool)
+    void writeGenericGraph(JsonStreamWriter& writer,
+                           const GenericGraph<NodeTy, EdgeTy>* graph,
+                           const std::vector<const EdgeTy*>& edgePool)
     {
-        cJSON* root = jsonCreateObject();
-
-        cJSON* allNode = jsonCreateArray();
+        writer.writeItem("nodeNum", toJson(graph->nodeNum));
+        writer.beginArray("allNode");
         for (const auto& pair : graph->IDToNodeMap)
         {
             NodeTy* node = pair.second;
-            cJSON* jsonNode = virtToJson(node);
-            jsonAddItemToArray(allNode, jsonNode);
+            writer.writeItem(nullptr, virtToJson(node));
         }
+        writer.endArray();
 
-        cJSON* allEdge = jsonCreateArray();
+        writer.writeItem("edgeNum", toJson(graph->edgeNum));
+        writer.beginArray("allEdge");
         for (const EdgeTy* edge : edgePool)
         {
-            cJSON* edgeJson = virtToJson(edge);
-            jsonAddItemToArray(allEdge, edgeJson);
+            writer.writeItem(nullptr, virtToJson(edge));
         }
-
-        JSON_WRITE_FIELD(root, graph, nodeNum);
-        jsonAddItemToObject(root, FIELD_NAME_ITEM(allNode));
-        JSON_WRITE_FIELD(root, graph, edgeNum);
-        jsonAddItemToObject(root, FIELD_NAME_ITEM(allEdge));
-
-        return root;
+        writer.endArray();
     }
 
     /** The following 2 functions are intended to convert SparseBitVectors
@@ -639,6 +708,37 @@ private:
         return jsonAddItemToObject(obj, name, itemObj);
     }
 
+    /// Write a field of an object being streamed. Containers are written
+    /// element by element, other values as a whole.
+    template <typename T>
+    void writeJsonable(JsonStreamWriter& writer, const char* name,
+                       const T& item)
+    {
+        writeJsonable(writer, name, item,
+                      std::integral_constant < bool,
+                      SVFUtil::is_iterable_v<T> &&
+                      !std::is_same<T, std::string>::value > {});
+    }
+
+    template <typename T>
+    void writeJsonable(JsonStreamWriter& writer, const char* name,
+                       const T& item, std::false_type)
+    {
+        writer.writeItem(name, toJson(item));
+    }
+
+    template <typename T>
+    void writeJsonable(JsonStreamWriter& writer, const char* name,
+                       const T& container, std::true_type)
+    {
+        writer.beginArray(name);
+        for (const auto& item : container)
+        {
+            writer.writeItem(nullptr, toJson(item));
+        }
+        writer.endArray();
+    }
+
     template <typename T>
     bool jsonAddContentToObject(cJSON* obj, const char* name, const T& item)
     {
@@ -685,7 +785,10 @@ template <typename T> using KindBaseT = typename KindBaseHelper<T>::type;
 template <typename T> class ReaderIDToObjMap
 {
 private:
-    using IDToPairMapTy = OrderedMap<unsigned, std::pair<const cJSON*, T*>>;
+    /// Object's JSON and the number of its fields consumed by the creator.
+    /// The JSON may be lazy, and is parsed again when filling the object.
+    using ObjJsonTy = std::pair<const cJSON*, u32_t>;
+    using IDToPairMapTy = OrderedMap<unsigned, std::pair<ObjJsonTy, T*>>;
     IDToPairMapTy idMap;
 
 public:
@@ -699,11 +802,15 @@ public:
 
         jsonForEach(objJson, idObjArrayJson)
         {
-            ABORT_IFNOT(jsonIsObject(objJson), "expects an object");
-            const cJSON* objFieldJson = objJson->child;
+            LazyJson lazyObj(objJson);
+            ABORT_IFNOT(jsonIsObject(lazyObj.get()), "expects an object");
+            const cJSON* objFieldJson = lazyObj.get()->child;
             // creator is allowed to change objFieldJson
             auto idObj = idObjCreator(objFieldJson);
-            auto pair = std::pair<const cJSON*, T*>(objFieldJson, idObj.second);
+            u32_t consumed =
+                jsonCountFields(lazyObj.get()->child, objFieldJson);
+            auto pair = std::make_pair(ObjJsonTy(objJson, consumed),
+                                       idObj.second);
             bool inserted = idMap.emplace(idObj.first, pair).second;
             ABORT_IFNOT(inserted, "ID " << idObj.first << " duplicated in "
                         << idObjArrayJson->string);
@@ -721,7 +828,10 @@ public:
     {
         for (auto& pair : idMap)
         {
-            const cJSON* objFieldJson = pair.second.first;
+            const ObjJsonTy& objJson = pair.second.first;
+            LazyJson lazyObj(objJson.first);
+            const cJSON* objFieldJson =
+                jsonSkipFields(lazyObj.get()->child, objJson.second);
             T* obj = pair.second.second;
             fillFunc(objFieldJson, obj);
 
@@ -752,7 +862,8 @@ public:
 template <typename T> class ReaderPtrPool
 {
 private:
-    std::vector<const cJSON*> jsonArray;
+    /// Objects' JSON and the number of their fields consumed by the creator
+    std::vector<std::pair<const cJSON*, u32_t>> jsonArray;
     std::vector<T*> ptrPool;
 
 public:
@@ -775,10 +886,12 @@ public:
 
         jsonForEach(objJson, objArrayJson)
         {
-            ABORT_IFNOT(jsonIsObject(objJson), "expects objects in array");
-            const cJSON* objFieldJson = objJson->child;
+            LazyJson lazyObj(objJson);
+            ABORT_IFNOT(jsonIsObject(lazyObj.get()), "expects objects in array");
+            const cJSON* objFieldJson = lazyObj.get()->child;
             T* obj = creator(objFieldJson);
-            jsonArray.push_back(objFieldJson);
+            jsonArray.emplace_back(
+                objJson, jsonCountFields(lazyObj.get()->child, objFieldJson));
             ptrPool.push_back(obj);
         }
     }
@@ -796,7 +909,9 @@ public:
                "jsonArray and ptrPool should have same size");
         for (size_t i = 0; i < jsonArray.size(); ++i)
         {
-            const cJSON*& objFieldJson = jsonArray[i];
+            LazyJson lazyObj(jsonArray[i].first);
+            const cJSON* objFieldJson =
+                jsonSkipFields(lazyObj.get()->child, jsonArray[i].second);
             fillFunc(objFieldJson, ptrPool[i]);
             ABORT_IFNOT(!objFieldJson, "json should be consumed by filler, but "
                         << objFieldJson->string << " left");
@@ -1121,7 +1236,8 @@ private:
         jsonForEach(nObj, obj)
         {
             unsigned n;
-            readJson(nObj, n);
+            LazyJson lazyN(nObj);
+            readJson(lazyN.get(), n);
             bv.set(n);
         }
     }
@@ -1164,8 +1280,10 @@ private:
     void readJson(const cJSON* obj, std::pair<T1, T2>& pair)
     {
         auto jpair = jsonUnpackPair(obj);
-        readJson(jpair.first, pair.first);
-        readJson(jpair.second, pair.second);
+        LazyJson first(jpair.first);
+        readJson(first.get(), pair.first);
+        LazyJson second(jpair.second);
+        readJson(second.get(), pair.second);
     }
 
     template <typename T, size_t N>
@@ -1176,7 +1294,8 @@ private:
         size_t i = 0;
         jsonForEach(elemJson, obj)
         {
-            readJson(elemJson, array[i]);
+            LazyJson elem(elemJson);
+            readJson(elem.get(), array[i]);
             if (++i >= N)
                 break;
         }
@@ -1193,7 +1312,8 @@ private:
         jsonForEach(elemJson, obj)
         {
             container.push_back(T{});
-            readJson(elemJson, container.back());
+            LazyJson elem(elemJson);
+            readJson(elem.get(), container.back());
         }
     }
 
@@ -1204,12 +1324,15 @@ private:
         ABORT_IFNOT(jsonIsMap(obj), "expects an map (represented by array)");
         jsonForEach(elemJson, obj)
         {
-            auto jpair = jsonUnpackPair(elemJson);
+            LazyJson elem(elemJson);
+            auto jpair = jsonUnpackPair(elem.get());
             typename C::key_type key{};
-            readJson(jpair.first, key);
+            LazyJson keyJson(jpair.first);
+            readJson(keyJson.get(), key);
             auto it = map.emplace(std::move(key), typename C::mapped_type{});
             ABORT_IFNOT(it.second, "Duplicated map key");
-            readJson(jpair.second, it.first->second);
+            LazyJson valueJson(jpair.second);
+            readJson(valueJson.get(), it.first->second);
         }
     }
 
@@ -1222,7 +1345,8 @@ private:
         jsonForEach(elemJson, obj)
         {
             T elem{};
-            readJson(elemJson, elem);
+            LazyJson lazyElem(elemJson);
+            readJson(lazyElem.get(), elem);
             auto inserted = set.insert(std::move(elem)).second;
             ABORT_IFNOT(inserted, "Duplicated set element");
         }
@@ -30,6 +30,7 @@
 #ifndef INCLUDE_SVFIR_SVFTYPE_H_
 #define INCLUDE_SVFIR_SVFTYPE_H_
 
+#include "Util/FlatHashMap.h"
 #include "Util/SparseBitVector.h"
 #include <cstdint>
 #include <deque>
@@ -91,6 +92,18 @@ template <class T> struct Hash
     }
 };
 
+/// Open addressing tables (Util/FlatHashMap.h) when built with SVF_FLAT_HASH_MAP
+#ifdef SVF_FLAT_HASH_MAP
+template <typename Key, typename Hash = Hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key> >
+using Set = FlatHashSet<Key, Hash, KeyEqual, Allocator>;
+
+template <typename Key, typename Value, typename Hash = Hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value> > >
+using Map = FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>;
+#else
 template <typename Key, typename Hash = Hash<Key>,
           typename KeyEqual = std::equal_to<Key>,
           typename Allocator = std::allocator<Key> >
@@ -100,6 +113,7 @@ template <typename Key, typename Value, typename Hash = Hash<Key>,
           typename KeyEqual = std::equal_to<Key>,
           typename Allocator = std::allocator<std::pair<const Key, Value> > >
 using Map = std::unordered_map<Key, Value, Hash, KeyEqual, Allocator>;
+#endif
 
 template <typename Key, typename Compare = std::less<Key>,
           typename Allocator = std::allocator<Key> >
@@ -120,7 +134,7 @@ typedef std::stack<NodeID> NodeStack;
 typedef std::list<NodeID> NodeList;
 typedef std::deque<NodeID> NodeDeque;
 typedef NodeSet EdgeSet;
-typedef std::vector<u32_t> CallStrCxt;
+class CallStrCxt; // Util/CallStrCxt.h
 typedef unsigned Version;
 typedef Set<Version> VersionSet;
 typedef std::pair<NodeID, Version> VersionedVar;
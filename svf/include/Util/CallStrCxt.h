@@ -0,0 +1,152 @@
+//===- CallStrCxt.h -- Interned call string contexts --------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * CallStrCxt.h
+ *
+ * Call string contexts (of MTA and context-sensitive DDA) are nodes of a trie of
+ * call site IDs shared by all contexts: a context is the path from the root (the
+ * empty context) to its node. A context is thus represented by the 32-bit ID of
+ * its node, so that copying, comparing, hashing, pushing and popping a context
+ * take constant time, and common prefixes are stored once.
+ */
+
+#ifndef INCLUDE_UTIL_CALLSTRCXT_H_
+#define INCLUDE_UTIL_CALLSTRCXT_H_
+
+#include "SVFIR/SVFType.h"
+
+namespace SVF
+{
+
+/*!
+ * Call string context: a sequence of call site IDs, the last one being the
+ * most recent call. The trie is global and never shrinks; it is not thread-safe.
+ */
+class CallStrCxt
+{
+public:
+    typedef u32_t CxtID;
+
+    /// The empty context
+    CallStrCxt() : id(0)
+    {
+    }
+
+    /// Number of call sites
+    inline u32_t size() const
+    {
+        return getNode(id).depth;
+    }
+    inline bool empty() const
+    {
+        return id == 0;
+    }
+    /// The most recent call site
+    inline CallSiteID back() const
+    {
+        assert(!empty() && "empty context has no call site");
+        return getNode(id).csId;
+    }
+    /// Push/pop the most recent call site
+    //@{
+    void push_back(CallSiteID csId);
+    inline void pop_back()
+    {
+        assert(!empty() && "pop from an empty context");
+        id = getNode(id).parent;
+    }
+    //@}
+    /// Remove the least recent call site (k-limiting), in O(size())
+    void pop_front();
+
+    /// The index-th call site, 0 being the least recent one, in O(size())
+    CallSiteID operator[](u32_t index) const;
+    /// Whether csId is one of the call sites, in O(size())
+    bool contains(CallSiteID csId) const;
+
+    /// Call sites from the least to the most recent one
+    std::vector<CallSiteID> toVector() const;
+    /// "[:cs1 cs2 ...  ]"
+    std::string toString() const;
+
+    inline CxtID getId() const
+    {
+        return id;
+    }
+    /// Total number of contexts created so far (including the empty one)
+    static u32_t getNumOfCxts();
+
+    /// Contexts are ordered by their IDs, i.e., in the order they are created.
+    //@{
+    inline bool operator<(const CallStrCxt& rhs) const
+    {
+        return id < rhs.id;
+    }
+    inline bool operator==(const CallStrCxt& rhs) const
+    {
+        return id == rhs.id;
+    }
+    inline bool operator!=(const CallStrCxt& rhs) const
+    {
+        return id != rhs.id;
+    }
+    //@}
+
+private:
+    /// Trie node: the context of parent extended with csId
+    struct Node
+    {
+        CxtID parent;
+        CallSiteID csId;
+        u32_t depth;
+    };
+
+    struct Trie
+    {
+        std::vector<Node> nodes;
+        /// (parent, call site) -> child
+        Map<u64_t, CxtID> children;
+        Trie();
+    };
+
+    static Trie& getTrie();
+    static inline const Node& getNode(CxtID id)
+    {
+        return getTrie().nodes[id];
+    }
+
+    CxtID id;
+};
+
+} // End namespace SVF
+
+template <> struct std::hash<SVF::CallStrCxt>
+{
+    size_t operator()(const SVF::CallStrCxt& cxt) const
+    {
+        std::hash<SVF::u32_t> h;
+        return h(cxt.getId());
+    }
+};
+
+#endif /* INCLUDE_UTIL_CALLSTRCXT_H_ */
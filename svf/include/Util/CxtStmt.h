@@ -31,6 +31,7 @@
 #define INCLUDE_UTIL_CXTSTMT_H_
 
 #include "SVFIR/SVFValue.h"
+#include "Util/CallStrCxt.h"
 
 namespace SVF
 {
@@ -95,15 +96,7 @@ public:
     /// Return context in string format
     inline std::string cxtToStr() const
     {
-        std::string str;
-        std::stringstream rawstr(str);
-        rawstr << "[:";
-        for(CallStrCxt::const_iterator it = cxt.begin(), eit = cxt.end(); it!=eit; ++it)
-        {
-            rawstr << *it << " ";
-        }
-        rawstr << " ]";
-        return rawstr.str();
+        return cxt.toString();
     }
     /// Dump CxtStmt
     inline void dump() const
@@ -243,15 +236,7 @@ public:
     /// Return context in string format
     inline std::string cxtToStr() const
     {
-        std::string str;
-        std::stringstream rawstr(str);
-        rawstr << "[:";
-        for(CallStrCxt::const_iterator it = cxt.begin(), eit = cxt.end(); it!=eit; ++it)
-        {
-            rawstr << *it << " ";
-        }
-        rawstr << " ]";
-        return rawstr.str();
+        return cxt.toString();
     }
 
     /// inloop, incycle attributes
@@ -364,15 +349,7 @@ public:
     /// Return context in string format
     inline std::string cxtToStr() const
     {
-        std::string str;
-        std::stringstream rawstr(str);
-        rawstr << "[:";
-        for (CallStrCxt::const_iterator it = cxt.begin(), eit = cxt.end(); it != eit; ++it)
-        {
-            rawstr << *it << " ";
-        }
-        rawstr << " ]";
-        return rawstr.str();
+        return cxt.toString();
     }
     /// Dump CxtProc
     inline void dump() const
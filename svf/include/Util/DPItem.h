@@ -31,6 +31,7 @@
 #define DPITEM_H_
 
 #include "MemoryModel/ConditionalPT.h"
+#include "Util/CallStrCxt.h"
 #include <algorithm>    // std::sort
 
 namespace SVF
@@ -206,7 +207,6 @@ public:
 class ContextCond
 {
 public:
-    typedef CallStrCxt::const_iterator const_iterator;
     /// Constructor
     ContextCond():concreteCxt(true)
     {
@@ -254,7 +254,7 @@ public:
     /// Whether contains callstring cxt
     inline bool containCallStr(NodeID cxt) const
     {
-        return std::find(context.begin(),context.end(),cxt) != context.end();
+        return context.contains(cxt);
     }
     /// Get context size
     inline u32_t cxtSize() const
@@ -292,7 +292,7 @@ public:
             if(!context.empty())
             {
                 setNonConcreteCxt();
-                context.erase(context.begin());
+                context.pop_front();
                 context.push_back(ctx);
             }
             return false;
@@ -346,28 +346,10 @@ public:
     {
         return !(*this==rhs);
     }
-    /// Begin iterators
-    inline const_iterator begin() const
-    {
-        return context.begin();
-    }
-    /// End iterators
-    inline const_iterator end() const
-    {
-        return context.end();
-    }
     /// Dump context condition
     inline std::string toString() const
     {
-        std::string str;
-        std::stringstream rawstr(str);
-        rawstr << "[:";
-        for(CallStrCxt::const_iterator it = context.begin(), eit = context.end(); it!=eit; ++it)
-        {
-            rawstr << *it << " ";
-        }
-        rawstr << " ]";
-        return rawstr.str();
+        return context.toString();
     }
 protected:
     CallStrCxt context;
@@ -0,0 +1,874 @@
+//===- FlatHashMap.h -- Open addressing hash map and set ---------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * FlatHashMap.h
+ *
+ * Hash map and set with open addressing in the style of Swiss tables: a control
+ * byte per slot (empty, deleted or 7 bits of the hash) is probed a group at a time,
+ * so most lookups touch one group of control bytes and the element they look for.
+ *
+ * Unlike flat Swiss tables, elements are not stored in the slots but in chunks
+ * allocated a few at a time, and slots point to them. Rehashing only moves the
+ * pointers, so references to elements stay valid until they are erased as with
+ * std::unordered_map/set, which much of SVF relies on (e.g., holding the points-to
+ * set of one node while inserting another). Iterators are invalidated by rehashing.
+ *
+ * With SVF_FLAT_HASH_MAP defined, Map and Set (SVFIR/SVFType.h) are these.
+ */
+
+#ifndef SVF_FLATHASHMAP_H
+#define SVF_FLATHASHMAP_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace SVF
+{
+
+namespace FlatHash
+{
+
+/// Control byte of a slot, the 7 low bits of the hash of a full slot
+typedef int8_t Ctrl;
+static constexpr Ctrl Empty = -128;
+static constexpr Ctrl Deleted = -2;
+/// Pads the control bytes of tables smaller than a group, never matches
+static constexpr Ctrl Sentinel = -1;
+
+/// The control bytes of the slots probed together, bit i of a match standing for slot i
+#ifdef __SSE2__
+class Group
+{
+public:
+    static constexpr size_t Width = 16;
+
+    explicit Group(const Ctrl* pos) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+    inline uint32_t match(Ctrl h) const
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h), ctrl)));
+    }
+    inline uint32_t matchEmpty() const
+    {
+        return match(Empty);
+    }
+    inline uint32_t matchEmptyOrDeleted() const
+    {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(Sentinel), ctrl)));
+    }
+
+private:
+    __m128i ctrl;
+};
+#else
+class Group
+{
+public:
+    static constexpr size_t Width = 8;
+
+    explicit Group(const Ctrl* pos) : ctrl(pos) {}
+
+    inline uint32_t match(Ctrl h) const
+    {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < Width; ++i)
+            if (ctrl[i] == h)
+                mask |= 1u << i;
+        return mask;
+    }
+    inline uint32_t matchEmpty() const
+    {
+        return match(Empty);
+    }
+    inline uint32_t matchEmptyOrDeleted() const
+    {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < Width; ++i)
+            if (ctrl[i] < Sentinel)
+                mask |= 1u << i;
+        return mask;
+    }
+
+private:
+    const Ctrl* ctrl;
+};
+#endif
+
+/// Spreads the bits of a hash, most SVF hashes being identities over IDs or pointers
+inline size_t mix(size_t h)
+{
+    uint64_t x = h;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return static_cast<size_t>(x);
+}
+
+struct Identity
+{
+    template <typename T> inline const T& operator()(const T& v) const
+    {
+        return v;
+    }
+};
+
+struct SelectFirst
+{
+    template <typename P> inline const typename P::first_type& operator()(const P& v) const
+    {
+        return v.first;
+    }
+};
+
+} // End namespace FlatHash
+
+/*!
+ * Open addressing hash table of Values, looked up by the Key KeyOf extracts.
+ * FlatHashMap and FlatHashSet below give it the interface of the std containers.
+ */
+template <typename Value, typename Key, typename KeyOf, typename Hasher, typename KeyEqual>
+class FlatHashTable
+{
+public:
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Hasher hasher;
+    typedef KeyEqual key_equal;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+
+protected:
+    typedef FlatHash::Ctrl Ctrl;
+    typedef FlatHash::Group Group;
+
+    /// Storage of an element, linked into the free list once it is erased
+    union Entry
+    {
+        Entry() {}
+        ~Entry() {}
+        Value value;
+        Entry* nextFree;
+    };
+
+    /// Entries are allocated in chunks, each at least as large as all previous ones
+    struct Chunk
+    {
+        Chunk* next;
+        size_t capacity;
+    };
+
+    static constexpr size_t npos = ~(size_t)0;
+
+public:
+    template <bool Const>
+    class Iter
+    {
+        friend class FlatHashTable;
+        template <bool> friend class Iter;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename FlatHashTable::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<Const, const Value*, Value*>::type pointer;
+        typedef typename std::conditional<Const, const Value&, Value&>::type reference;
+
+        Iter() : ctrl(nullptr), end(nullptr), slot(nullptr) {}
+
+        /// iterator to const_iterator
+        template <bool C, typename = typename std::enable_if<Const && !C>::type>
+        Iter(const Iter<C>& it) : ctrl(it.ctrl), end(it.end), slot(it.slot) {}
+
+        inline reference operator*() const
+        {
+            return (*slot)->value;
+        }
+        inline pointer operator->() const
+        {
+            return &(*slot)->value;
+        }
+        inline Iter& operator++()
+        {
+            ++ctrl;
+            ++slot;
+            skipFree();
+            return *this;
+        }
+        inline Iter operator++(int)
+        {
+            Iter it = *this;
+            ++*this;
+            return it;
+        }
+        template <bool C> inline bool operator==(const Iter<C>& rhs) const
+        {
+            return ctrl == rhs.ctrl;
+        }
+        template <bool C> inline bool operator!=(const Iter<C>& rhs) const
+        {
+            return ctrl != rhs.ctrl;
+        }
+
+    private:
+        Iter(const Ctrl* c, const Ctrl* e, Entry* const* s) : ctrl(c), end(e), slot(s) {}
+
+        inline void skipFree()
+        {
+            while (ctrl != end && *ctrl < 0)
+            {
+                ++ctrl;
+                ++slot;
+            }
+        }
+
+        const Ctrl* ctrl;
+        const Ctrl* end;
+        Entry* const* slot;
+    };
+
+    typedef Iter<true> const_iterator;
+    /// Elements of sets are immutable
+    typedef typename std::conditional<std::is_same<Key, Value>::value, Iter<true>, Iter<false>>::type iterator;
+
+    /// Constructors and assignments
+    //@{
+    FlatHashTable(const Hasher& hf = Hasher(), const KeyEqual& eq = KeyEqual())
+        : ctrl(nullptr), slots(nullptr), capacity(0), num(0), growthLeft(0),
+          chunks(nullptr), chunkUsed(0), entryCapacity(0), freeList(nullptr), hashFn(hf), eqFn(eq)
+    {
+    }
+    explicit FlatHashTable(size_t n, const Hasher& hf = Hasher(), const KeyEqual& eq = KeyEqual())
+        : FlatHashTable(hf, eq)
+    {
+        reserve(n);
+    }
+    template <typename InputIt>
+    FlatHashTable(InputIt first, InputIt last, size_t n = 0, const Hasher& hf = Hasher(),
+                  const KeyEqual& eq = KeyEqual())
+        : FlatHashTable(n, hf, eq)
+    {
+        insert(first, last);
+    }
+    FlatHashTable(std::initializer_list<value_type> init, size_t n = 0, const Hasher& hf = Hasher(),
+                  const KeyEqual& eq = KeyEqual())
+        : FlatHashTable(init.begin(), init.end(), n, hf, eq)
+    {
+    }
+    FlatHashTable(const FlatHashTable& other) : FlatHashTable(other.hashFn, other.eqFn)
+    {
+        reserve(other.num);
+        for (const value_type& v : other)
+            insertUnique(v);
+    }
+    FlatHashTable(FlatHashTable&& other) noexcept : FlatHashTable(other.hashFn, other.eqFn)
+    {
+        swap(other);
+    }
+    FlatHashTable& operator=(const FlatHashTable& other)
+    {
+        if (this != &other)
+        {
+            FlatHashTable copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept
+    {
+        if (this != &other)
+        {
+            FlatHashTable moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+    FlatHashTable& operator=(std::initializer_list<value_type> init)
+    {
+        clear();
+        insert(init.begin(), init.end());
+        return *this;
+    }
+    ~FlatHashTable()
+    {
+        destroyEntries();
+        ::operator delete(slots);
+    }
+    //@}
+
+    /// Iterators
+    //@{
+    inline iterator begin()
+    {
+        return iteratorAt<iterator>(0);
+    }
+    inline iterator end()
+    {
+        return iterator(ctrl + capacity, ctrl + capacity, slots + capacity);
+    }
+    inline const_iterator begin() const
+    {
+        return iteratorAt<const_iterator>(0);
+    }
+    inline const_iterator end() const
+    {
+        return const_iterator(ctrl + capacity, ctrl + capacity, slots + capacity);
+    }
+    inline const_iterator cbegin() const
+    {
+        return begin();
+    }
+    inline const_iterator cend() const
+    {
+        return end();
+    }
+    //@}
+
+    inline size_t size() const
+    {
+        return num;
+    }
+    inline bool empty() const
+    {
+        return num == 0;
+    }
+
+    /// Lookup
+    //@{
+    inline iterator find(const Key& k)
+    {
+        size_t s = findSlot(k, hashOf(k));
+        return s == npos ? end() : iterator(ctrl + s, ctrl + capacity, slots + s);
+    }
+    inline const_iterator find(const Key& k) const
+    {
+        size_t s = findSlot(k, hashOf(k));
+        return s == npos ? end() : const_iterator(ctrl + s, ctrl + capacity, slots + s);
+    }
+    inline size_t count(const Key& k) const
+    {
+        return findSlot(k, hashOf(k)) != npos;
+    }
+    //@}
+
+    /// Insertion
+    //@{
+    inline std::pair<iterator, bool> insert(const value_type& v)
+    {
+        return insertWithKey(KeyOf()(v), v);
+    }
+    inline std::pair<iterator, bool> insert(value_type&& v)
+    {
+        return insertWithKey(KeyOf()(v), std::move(v));
+    }
+    inline iterator insert(const_iterator, const value_type& v)
+    {
+        return insert(v).first;
+    }
+    inline iterator insert(const_iterator, value_type&& v)
+    {
+        return insert(std::move(v)).first;
+    }
+    template <typename InputIt> void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+            emplace(*first);
+    }
+    inline void insert(std::initializer_list<value_type> init)
+    {
+        insert(init.begin(), init.end());
+    }
+    /// The element is built before looking up its key, and dropped if the key is present
+    template <typename... Args> std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        Entry* e = newEntry();
+        new (&e->value) Value(std::forward<Args>(args)...);
+        const Key& k = KeyOf()(e->value);
+        size_t h = hashOf(k);
+        size_t s = findSlot(k, h);
+        if (s != npos)
+        {
+            e->value.~Value();
+            releaseEntry(e);
+            return std::make_pair(iterator(ctrl + s, ctrl + capacity, slots + s), false);
+        }
+        s = prepareInsert(h);
+        setSlot(s, h, e);
+        return std::make_pair(iterator(ctrl + s, ctrl + capacity, slots + s), true);
+    }
+    template <typename... Args> inline iterator emplace_hint(const_iterator, Args&&... args)
+    {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+    //@}
+
+    /// Removal
+    //@{
+    size_t erase(const Key& k)
+    {
+        size_t s = findSlot(k, hashOf(k));
+        if (s == npos)
+            return 0;
+        eraseSlot(s);
+        return 1;
+    }
+    iterator erase(const_iterator it)
+    {
+        size_t s = it.ctrl - ctrl;
+        eraseSlot(s);
+        return iteratorAt<iterator>(s + 1);
+    }
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        while (first != last)
+            first = erase(first);
+        return iteratorAt<iterator>(last.ctrl - ctrl);
+    }
+    void clear()
+    {
+        destroyEntries();
+        if (capacity)
+            resetCtrl();
+        num = 0;
+        growthLeft = maxLoad(capacity);
+    }
+    //@}
+
+    /// Make room for n elements without rehashing
+    void reserve(size_t n)
+    {
+        if (n > num + growthLeft)
+            resize(capacityFor(n));
+        if (chunks == nullptr && n)
+            addChunk(n);
+    }
+
+    void swap(FlatHashTable& other) noexcept
+    {
+        std::swap(ctrl, other.ctrl);
+        std::swap(slots, other.slots);
+        std::swap(capacity, other.capacity);
+        std::swap(num, other.num);
+        std::swap(growthLeft, other.growthLeft);
+        std::swap(chunks, other.chunks);
+        std::swap(chunkUsed, other.chunkUsed);
+        std::swap(entryCapacity, other.entryCapacity);
+        std::swap(freeList, other.freeList);
+        std::swap(hashFn, other.hashFn);
+        std::swap(eqFn, other.eqFn);
+    }
+
+    inline hasher hash_function() const
+    {
+        return hashFn;
+    }
+    inline key_equal key_eq() const
+    {
+        return eqFn;
+    }
+
+    friend bool operator==(const FlatHashTable& lhs, const FlatHashTable& rhs)
+    {
+        if (lhs.size() != rhs.size())
+            return false;
+        for (const value_type& v : lhs)
+        {
+            const_iterator it = rhs.find(KeyOf()(v));
+            if (it == rhs.end() || !(*it == v))
+                return false;
+        }
+        return true;
+    }
+    friend bool operator!=(const FlatHashTable& lhs, const FlatHashTable& rhs)
+    {
+        return !(lhs == rhs);
+    }
+    friend void swap(FlatHashTable& lhs, FlatHashTable& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+protected:
+    inline size_t hashOf(const Key& k) const
+    {
+        return FlatHash::mix(hashFn(k));
+    }
+
+    /// Slot of key k whose hash is h, npos if k is absent
+    size_t findSlot(const Key& k, size_t h) const
+    {
+        if (capacity == 0)
+            return npos;
+        const size_t mask = capacity - 1;
+        const Ctrl h2 = static_cast<Ctrl>(h & 0x7f);
+        size_t pos = (h >> 7) & mask;
+        for (size_t step = Group::Width;; step += Group::Width)
+        {
+            Group g(ctrl + pos);
+            for (uint32_t m = g.match(h2); m; m &= m - 1)
+            {
+                size_t s = (pos + __builtin_ctz(m)) & mask;
+                if (eqFn(KeyOf()(slots[s]->value), k))
+                    return s;
+            }
+            if (g.matchEmpty())
+                return npos;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    /// First empty or deleted slot on the probe sequence of hash h
+    size_t findFreeSlot(size_t h) const
+    {
+        const size_t mask = capacity - 1;
+        size_t pos = (h >> 7) & mask;
+        for (size_t step = Group::Width;; step += Group::Width)
+        {
+            uint32_t m = Group(ctrl + pos).matchEmptyOrDeleted();
+            if (m)
+                return (pos + __builtin_ctz(m)) & mask;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    /// Slot for a new element whose hash is h, rehashing first if the table is full
+    size_t prepareInsert(size_t h)
+    {
+        if (growthLeft == 0)
+        {
+            // Drop the deleted slots in place if they are what fills the table
+            if (capacity == 0)
+                resize(MinCapacity);
+            else if (num * 2 <= maxLoad(capacity))
+                resize(capacity);
+            else
+                resize(capacity * 2);
+        }
+        size_t s = findFreeSlot(h);
+        if (ctrl[s] == FlatHash::Empty)
+            --growthLeft;
+        return s;
+    }
+
+    template <typename... Args> std::pair<iterator, bool> insertWithKey(const Key& k, Args&&... args)
+    {
+        size_t h = hashOf(k);
+        size_t s = findSlot(k, h);
+        if (s != npos)
+            return std::make_pair(iterator(ctrl + s, ctrl + capacity, slots + s), false);
+        s = prepareInsert(h);
+        Entry* e = newEntry();
+        new (&e->value) Value(std::forward<Args>(args)...);
+        setSlot(s, h, e);
+        return std::make_pair(iterator(ctrl + s, ctrl + capacity, slots + s), true);
+    }
+
+    /// Insert v whose key is known to be absent
+    void insertUnique(const value_type& v)
+    {
+        size_t h = hashOf(KeyOf()(v));
+        size_t s = prepareInsert(h);
+        Entry* e = newEntry();
+        new (&e->value) Value(v);
+        setSlot(s, h, e);
+    }
+
+    inline void setSlot(size_t s, size_t h, Entry* e)
+    {
+        setCtrl(s, static_cast<Ctrl>(h & 0x7f));
+        slots[s] = e;
+        ++num;
+    }
+
+    /// The first Width control bytes are mirrored after the last slot, so that a group
+    /// starting at any slot can be loaded at once
+    inline void setCtrl(size_t s, Ctrl c)
+    {
+        ctrl[s] = c;
+        if (s < Group::Width)
+            ctrl[capacity + s] = c;
+    }
+
+    void eraseSlot(size_t s)
+    {
+        Entry* e = slots[s];
+        e->value.~Value();
+        releaseEntry(e);
+        --num;
+
+        // The slot can be emptied if no group containing it has been full, as no probe
+        // sequence can then have gone past it
+        if (capacity >= Group::Width)
+        {
+            const size_t mask = capacity - 1;
+            uint32_t before = Group(ctrl + ((s - Group::Width) & mask)).matchEmpty();
+            uint32_t after = Group(ctrl + s).matchEmpty();
+            if (before && after)
+            {
+                size_t fullBefore = __builtin_clz(before) - (32 - Group::Width);
+                size_t fullAfter = __builtin_ctz(after);
+                if (fullBefore + fullAfter < Group::Width)
+                {
+                    setCtrl(s, FlatHash::Empty);
+                    ++growthLeft;
+                    return;
+                }
+            }
+        }
+        setCtrl(s, FlatHash::Deleted);
+    }
+
+    template <typename It> inline It iteratorAt(size_t s) const
+    {
+        It it(ctrl + s, ctrl + capacity, slots + s);
+        it.skipFree();
+        return it;
+    }
+
+    /// Tables hold at most 7/8 of their capacity (all but one slot when small)
+    static inline size_t maxLoad(size_t cap)
+    {
+        return cap < 8 ? (cap ? cap - 1 : 0) : cap - cap / 8;
+    }
+    static size_t capacityFor(size_t n)
+    {
+        size_t cap = MinCapacity;
+        while (maxLoad(cap) < n)
+            cap *= 2;
+        return cap;
+    }
+
+    /// Rebuild the table with newCap slots, newCap being a power of two
+    void resize(size_t newCap)
+    {
+        Ctrl* oldCtrl = ctrl;
+        Entry** oldSlots = slots;
+        size_t oldCap = capacity;
+
+        char* buf = static_cast<char*>(::operator new(newCap * sizeof(Entry*) + newCap + Group::Width));
+        slots = reinterpret_cast<Entry**>(buf);
+        ctrl = reinterpret_cast<Ctrl*>(buf + newCap * sizeof(Entry*));
+        capacity = newCap;
+        resetCtrl();
+        growthLeft = maxLoad(newCap) - num;
+
+        for (size_t i = 0; i < oldCap; ++i)
+        {
+            if (oldCtrl[i] < 0)
+                continue;
+            Entry* e = oldSlots[i];
+            size_t h = hashOf(KeyOf()(e->value));
+            size_t s = findFreeSlot(h);
+            setCtrl(s, static_cast<Ctrl>(h & 0x7f));
+            slots[s] = e;
+        }
+        ::operator delete(oldSlots);
+    }
+
+    void resetCtrl()
+    {
+        std::memset(ctrl, FlatHash::Empty, capacity);
+        size_t mirrored = capacity < Group::Width ? capacity : Group::Width;
+        std::memset(ctrl + capacity, FlatHash::Empty, mirrored);
+        std::memset(ctrl + capacity + mirrored, FlatHash::Sentinel, Group::Width - mirrored);
+    }
+
+    /// Entry storage
+    //@{
+    static constexpr size_t chunkHeader()
+    {
+        return (sizeof(Chunk) + alignof(Entry) - 1) / alignof(Entry) * alignof(Entry);
+    }
+    static inline Entry* chunkEntries(Chunk* c)
+    {
+        return reinterpret_cast<Entry*>(reinterpret_cast<char*>(c) + chunkHeader());
+    }
+    void addChunk(size_t n)
+    {
+        static_assert(alignof(Entry) <= alignof(std::max_align_t), "over-aligned elements");
+        Chunk* c = static_cast<Chunk*>(::operator new(chunkHeader() + n * sizeof(Entry)));
+        c->next = chunks;
+        c->capacity = n;
+        chunks = c;
+        chunkUsed = 0;
+        entryCapacity += n;
+    }
+    inline Entry* newEntry()
+    {
+        if (freeList)
+        {
+            Entry* e = freeList;
+            freeList = e->nextFree;
+            return e;
+        }
+        if (chunks == nullptr || chunkUsed == chunks->capacity)
+            addChunk(entryCapacity < MinCapacity ? MinCapacity : entryCapacity);
+        return new (chunkEntries(chunks) + chunkUsed++) Entry;
+    }
+    inline void releaseEntry(Entry* e)
+    {
+        e->nextFree = freeList;
+        freeList = e;
+    }
+    /// Destroy all elements and free their storage
+    void destroyEntries()
+    {
+        if (!std::is_trivially_destructible<Value>::value)
+        {
+            for (size_t i = 0; i < capacity; ++i)
+                if (ctrl[i] >= 0)
+                    slots[i]->value.~Value();
+        }
+        while (chunks)
+        {
+            Chunk* next = chunks->next;
+            ::operator delete(chunks);
+            chunks = next;
+        }
+        chunkUsed = 0;
+        entryCapacity = 0;
+        freeList = nullptr;
+    }
+    //@}
+
+    static constexpr size_t MinCapacity = 4;
+
+    Ctrl* ctrl;             ///< capacity + Group::Width control bytes
+    Entry** slots;          ///< capacity slots, allocated together with ctrl
+    size_t capacity;        ///< 0 or a power of two
+    size_t num;             ///< number of elements
+    size_t growthLeft;      ///< empty slots which can be filled before rehashing
+    Chunk* chunks;          ///< entry chunks, the one being filled first
+    size_t chunkUsed;       ///< entries handed out from the first chunk
+    size_t entryCapacity;   ///< entries in all chunks
+    Entry* freeList;        ///< entries of erased elements
+    Hasher hashFn;
+    KeyEqual eqFn;
+};
+
+template <typename Value, typename Key, typename KeyOf, typename Hasher, typename KeyEqual>
+constexpr size_t FlatHashTable<Value, Key, KeyOf, Hasher, KeyEqual>::npos;
+template <typename Value, typename Key, typename KeyOf, typename Hasher, typename KeyEqual>
+constexpr size_t FlatHashTable<Value, Key, KeyOf, Hasher, KeyEqual>::MinCapacity;
+
+/*!
+ * Drop-in replacement of std::unordered_map. The allocator is kept for source
+ * compatibility and is not used.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class FlatHashMap : public FlatHashTable<std::pair<const Key, Value>, Key, FlatHash::SelectFirst, Hash, KeyEqual>
+{
+    typedef FlatHashTable<std::pair<const Key, Value>, Key, FlatHash::SelectFirst, Hash, KeyEqual> Base;
+
+public:
+    typedef Value mapped_type;
+    typedef Allocator allocator_type;
+    typedef typename Base::value_type value_type;
+    typedef typename Base::iterator iterator;
+    typedef typename Base::const_iterator const_iterator;
+
+    using Base::Base;
+    using Base::insert;
+
+    FlatHashMap() = default;
+
+    template <typename P, typename = typename std::enable_if<std::is_constructible<value_type, P&&>::value>::type>
+    inline std::pair<iterator, bool> insert(P&& p)
+    {
+        return this->emplace(std::forward<P>(p));
+    }
+
+    template <typename... Args> inline std::pair<iterator, bool> try_emplace(const Key& k, Args&&... args)
+    {
+        return this->insertWithKey(k, std::piecewise_construct, std::forward_as_tuple(k),
+                                   std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    template <typename... Args> inline std::pair<iterator, bool> try_emplace(Key&& k, Args&&... args)
+    {
+        return this->insertWithKey(k, std::piecewise_construct, std::forward_as_tuple(std::move(k)),
+                                   std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    inline Value& operator[](const Key& k)
+    {
+        return try_emplace(k).first->second;
+    }
+    inline Value& operator[](Key&& k)
+    {
+        return try_emplace(std::move(k)).first->second;
+    }
+
+    inline Value& at(const Key& k)
+    {
+        iterator it = this->find(k);
+        assert(it != this->end() && "key not in the map");
+        return it->second;
+    }
+    inline const Value& at(const Key& k) const
+    {
+        const_iterator it = this->find(k);
+        assert(it != this->end() && "key not in the map");
+        return it->second;
+    }
+};
+
+/*!
+ * Drop-in replacement of std::unordered_set. The allocator is kept for source
+ * compatibility and is not used.
+ */
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+class FlatHashSet : public FlatHashTable<Key, Key, FlatHash::Identity, Hash, KeyEqual>
+{
+    typedef FlatHashTable<Key, Key, FlatHash::Identity, Hash, KeyEqual> Base;
+
+public:
+    typedef Allocator allocator_type;
+
+    using Base::Base;
+
+    FlatHashSet() = default;
+};
+
+} // End namespace SVF
+
+#endif // SVF_FLATHASHMAP_H
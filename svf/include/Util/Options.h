@@ -68,6 +68,12 @@ public:
     /// PTData type.
     static const OptionMap<BVDataPTAImpl::PTBackingType> ptDataBacking;
 
+    /// Number of points-to sets in the persistent cache that triggers garbage collection.
+    static const Option<u32_t> PtsGCThreshold;
+
+    /// Maximum number of entries in each persistent points-to operation cache.
+    static const Option<u32_t> PtsOpCacheLimit;
+
     /// Time limit for the main phase (i.e., the actual solving) of FS analyses.
     static const Option<u32_t> FsTimeLimit;
 
@@ -77,6 +83,15 @@ public:
     /// Number of threads for the versioning phase.
     static const Option<u32_t> VersioningThreads;
 
+    /// Number of threads for the version propagation of the versioned flow-sensitive solver.
+    static const Option<u32_t> VFSThreads;
+
+    /// Number of threads for the wave propagation of AndersenWaveDiff.
+    static const Option<u32_t> AnderThreads;
+
+    /// Number of threads for SCC detection on the SVFG by flow-sensitive analyses.
+    static const Option<u32_t> SCCThreads;
+
     // ContextDDA.cpp
     static const Option<u32_t> CxtBudget;
 
@@ -102,6 +117,8 @@ public:
     static const Option<bool> PrintQueryPts;
     static const Option<bool> WPANum;
     static OptionMultiple<PointerAnalysis::PTATY> DDASelected;
+    static const Option<std::string> DDAServer;
+    static const Option<u32_t> DDACacheBudget;
 
     // FlowDDA.cpp
     static const Option<u32_t> FlowBudget;
@@ -136,6 +153,7 @@ public:
     static const Option<bool> DumpICFG;
     static const Option<std::string> DumpJson;
     static const Option<bool> ReadJson;
+    static const Option<std::string> SVFIRCacheDir;
     static const Option<bool> CallGraphDotGraph;
     static const Option<bool> PAGPrint;
     static const Option<u32_t> IndirectCallLimit;
@@ -155,6 +173,7 @@ public:
     static const Option<std::string> MSSAFun;
     // static const llvm::cl::opt<string> MSSAFun;
     static const OptionMap<MemSSA::MemPartition> MemPar;
+    static const Option<u32_t> MSSAThreads;
 
     // SVFG builder (SVFGBuilder.cpp)
     static const Option<bool> SVFGWithIndirectCall;
@@ -162,12 +181,14 @@ public:
 
     static const Option<std::string> WriteSVFG;
     static const Option<std::string> ReadSVFG;
+    static const Option<bool> SVFGTextFormat;
 
     // FSMPTA.cpp
     static const Option<bool> UsePCG;
     static const Option<bool> IntraLock;
     static const Option<bool> ReadPrecisionTDEdge;
     static const Option<u32_t> AddModelFlag;
+    static const Option<u32_t> TDEdgeThreads;
 
     // LockAnalysis.cpp
     static const Option<bool> PrintLockSpan;
@@ -202,6 +223,7 @@ public:
     // Source-sink analyzer (SrcSnkDDA.cpp)
     static const Option<bool> DumpSlice;
     static const Option<u32_t> CxtLimit;
+    static const Option<u32_t> SaberThreads;
 
     // CHG.cpp
     static const Option<bool> DumpCHA;
@@ -212,6 +234,7 @@ public:
     // LLVMModule.cpp
     static const Option<std::string> Graphtxt;
     static const Option<bool> SVFMain;
+    static const Option<u32_t> LoadThreads;
 
     // SymbolTableInfo.cpp
     static const Option<bool> LocMemModel;
@@ -243,6 +266,8 @@ public:
     static const Option<std::string> WriteAnder;
     // static const Option<string> ReadAnder;
     static const Option<std::string> ReadAnder;
+    static const Option<bool> BinaryAnder;
+    static const Option<std::string> IncrementalAnder;
     static const Option<bool> DiffPts;
     static Option<bool> DetectPWC;
     static const Option<bool> VtableInSVFIR;
@@ -267,6 +292,8 @@ public:
     static const Option<bool>  CFLSVFG;
     static const Option<bool> POCRAlias;
     static const Option<bool> POCRHybrid;
+    static const Option<bool> CFLBitMatrix;
+    static const Option<bool> CFLEdgeTriples;
     static const Option<bool> Customized;
 
     // Loop Analysis
@@ -0,0 +1,117 @@
+//===- PhaseStat.h -- Timing and memory of analysis phases -------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PhaseStat.h
+ *
+ * Records the wall time, CPU time and peak resident set size of the phases of
+ * the analysis pipeline (module loading, SVFIR building, Andersen's analysis, ...),
+ * independently of the clock options used by the per-analysis statistics.
+ */
+
+#ifndef SVF_PHASESTAT_H
+#define SVF_PHASESTAT_H
+
+#include "SVFIR/SVFType.h"
+
+namespace SVF
+{
+
+class PhaseStat
+{
+public:
+    /// A finished phase. Phases may nest (e.g., the SVFG built by a flow-sensitive
+    /// analysis), depth being the number of enclosing phases.
+    struct Phase
+    {
+        std::string name;
+        u32_t depth;
+        double wallTime;    ///< seconds
+        double cpuTime;     ///< seconds, user and system time of all threads
+        u64_t peakRSS;      ///< KB
+    };
+    typedef std::vector<Phase> PhaseList;
+
+    /// Records the phase spanning the lifetime of the object (when recording is enabled).
+    class Scope
+    {
+    public:
+        explicit Scope(const std::string& name) : active(PhaseStat::isEnabled())
+        {
+            if (active)
+                PhaseStat::startPhase(name);
+        }
+        ~Scope()
+        {
+            if (active)
+                PhaseStat::endPhase();
+        }
+    private:
+        bool active;
+    };
+
+    /// Phases are only recorded once enabled (e.g., by svf-bench).
+    static inline void setEnabled(bool e)
+    {
+        enabled = e;
+    }
+    static inline bool isEnabled()
+    {
+        return enabled;
+    }
+
+    static void startPhase(const std::string& name);
+    static void endPhase();
+
+    /// Finished phases, in the order they started
+    static inline const PhaseList& getPhases()
+    {
+        return phases;
+    }
+    static void clear();
+
+private:
+    /// A phase which has not finished yet
+    struct OpenPhase
+    {
+        size_t index;       ///< position in phases
+        double wallStart;
+        double cpuStart;
+        u64_t peakRSS;
+    };
+
+    static double getWallTime();
+    static double getCPUTime();
+    /// High-water mark of the resident set size in KB, and its reset to the current size
+    //@{
+    static u64_t getPeakRSS();
+    static void resetPeakRSS();
+    //@}
+
+    static bool enabled;
+    static PhaseList phases;
+    static std::vector<OpenPhase> openPhases;
+};
+
+} // End namespace SVF
+
+#endif //SVF_PHASESTAT_H
@@ -33,6 +33,12 @@
  *
  * And influenced by implementation from Open64 compiler
  *
+ * The depth-first search keeps its own stack so that long chains do not overflow the
+ * call stack, and per-node state lives in tables indexed by node ID. findParallel()
+ * first trims nodes that cannot be in a cycle and then finds the largest component by
+ * a forward-backward search, following Hong, Ung and Yang, "On Fast Parallel Detection
+ * of Strongly Connected Components (SCC) in Small-World Graphs", SC 2013.
+ *
  *  Created on: Jul 12, 2013
  *      Author: yusui
  */
@@ -42,14 +48,17 @@
 
 #include "SVFIR/SVFValue.h"	// for NodeBS
 #include <limits.h>
+#include <algorithm>
+#include <atomic>
 #include <stack>
 #include <map>
+#include <memory>
+#include <thread>
+#include <vector>
 
 namespace SVF
 {
 
-class GNodeSCCInfo;
-
 template<class GraphType>
 class SCCDetection
 {
@@ -65,60 +74,10 @@ private:
 public:
     typedef std::stack<NodeID> GNodeStack;
 
-    class GNodeSCCInfo
-    {
-    public:
-        GNodeSCCInfo() : _visited(false), _inSCC(false), _rep(UINT_MAX) {}
-
-        inline bool visited(void) const
-        {
-            return _visited;
-        }
-        inline void visited(bool v)
-        {
-            _visited = v;
-        }
-        inline bool inSCC(void)   const
-        {
-            return _inSCC;
-        }
-        inline void inSCC(bool v)
-        {
-            _inSCC = v;
-        }
-        inline NodeID rep(void)const
-        {
-            return _rep;
-        }
-        inline void rep(NodeID n)
-        {
-            _rep = n;
-        }
-        inline void addSubNodes(NodeID n)
-        {
-            _subNodes.set(n);
-        }
-        inline NodeBS& subNodes()
-        {
-            return _subNodes;
-        }
-        inline const NodeBS& subNodes() const
-        {
-            return _subNodes;
-        }
-    private:
-        bool     _visited;
-        bool     _inSCC;
-        NodeID  _rep;
-        NodeBS _subNodes; /// nodes in the scc represented by this node
-    };
-
-    typedef Map<NodeID,GNodeSCCInfo > GNODESCCInfoMap;
-    typedef Map<NodeID, NodeID> NodeToNodeMap;
-
     SCCDetection(const GraphType &GT)
         : _graph(GT),
-          _I(0)
+          _I(0),
+          _denseLimit(0)
     {}
 
 
@@ -130,17 +89,12 @@ public:
         return _T;
     }
 
-    const inline  GNODESCCInfoMap &GNodeSCCInfo() const
-    {
-        return _NodeSCCAuxInfo;
-    }
-
     /// get the rep node if not found return itself
     inline NodeID repNode(NodeID n) const
     {
-        typename GNODESCCInfoMap::const_iterator it = _NodeSCCAuxInfo.find(n);
-        assert(it!=_NodeSCCAuxInfo.end() && "scc rep not found");
-        NodeID rep = it->second.rep();
+        const NodeInfo* nInfo = getInfo(n);
+        assert(nInfo && "scc rep not found");
+        NodeID rep = nInfo->rep;
         return rep!= UINT_MAX ? rep : n ;
     }
 
@@ -172,9 +126,9 @@ public:
     /// get all subnodes in one scc, if size is empty insert itself into the set
     inline const NodeBS& subNodes(NodeID n)  const
     {
-        typename GNODESCCInfoMap::const_iterator it = _NodeSCCAuxInfo.find(n);
-        assert(it!=_NodeSCCAuxInfo.end() && "scc rep not found");
-        return it->second.subNodes();
+        const NodeInfo* nInfo = getInfo(n);
+        assert(nInfo && "scc rep not found");
+        return nInfo->subNodes;
     }
 
     /// get all repNodeID
@@ -189,51 +143,85 @@ public:
     }
 private:
 
-    GNODESCCInfoMap  _NodeSCCAuxInfo;
+    /// State of a visited node
+    struct NodeInfo
+    {
+        NodeID d;           ///< visiting order, 0 until the node is visited
+        NodeID rep;
+        bool inSCC;
+        NodeBS subNodes;    ///< nodes in the scc represented by this node
+
+        NodeInfo() : d(0), rep(UINT_MAX), inSCC(false) {}
+    };
+
+    /// A node on the depth-first search stack and its children left to visit
+    struct Frame
+    {
+        NodeID node;
+        child_iterator child;
+        child_iterator childEnd;
+    };
 
     const GraphType &           _graph;
     NodeID                   _I;
-    NodeToNodeMap            _D;
     GNodeStack             _SS;
     GNodeStack             _T;
     NodeBS repNodes;
 
-    inline bool visited(NodeID n)
+    /// Node states, indexed by ID for IDs below _denseLimit (a few times the number of
+    /// nodes, see clear()) and hashed for the others.
+    //@{
+    std::vector<NodeInfo> _info;
+    Map<NodeID, NodeInfo> _farInfo;
+    size_t _denseLimit;
+    //@}
+    std::vector<NodeID> _visitedNodes;  ///< nodes whose state clear() resets
+    std::vector<Frame> _dfs;
+
+    inline const NodeInfo* getInfo(NodeID n) const
     {
-        return _NodeSCCAuxInfo[n].visited();
+        const NodeInfo* nInfo = nullptr;
+        if (n < _info.size())
+            nInfo = &_info[n];
+        else
+        {
+            typename Map<NodeID, NodeInfo>::const_iterator it = _farInfo.find(n);
+            if (it != _farInfo.end())
+                nInfo = &it->second;
+        }
+        return nInfo && nInfo->d ? nInfo : nullptr;
     }
-    inline bool inSCC(NodeID n)
+    /// State of a visited node
+    inline NodeInfo& info(NodeID n)
     {
-        return _NodeSCCAuxInfo[n].inSCC();
+        return n < _info.size() ? _info[n] : _farInfo[n];
     }
-
-    inline void setVisited(NodeID n,bool v)
+    /// Start the state of n, invalidating the references returned by info()
+    NodeInfo& markVisited(NodeID n)
     {
-        _NodeSCCAuxInfo[n].visited(v);
+        if (n >= _info.size() && n < _denseLimit)
+            _info.resize(std::min(std::max<size_t>(n + 1, 2 * _info.size()), _denseLimit));
+        NodeInfo& nInfo = info(n);
+        nInfo.d = ++_I;
+        _visitedNodes.push_back(n);
+        return nInfo;
     }
-    inline void setInSCC(NodeID n,bool v)
+
+    inline bool visited(NodeID n) const
     {
-        _NodeSCCAuxInfo[n].inSCC(v);
+        return n < _info.size() ? _info[n].d != 0 : getInfo(n) != nullptr;
     }
-    inline void rep(NodeID n, NodeID r)
+    inline bool inSCC(NodeID n)
     {
-        _NodeSCCAuxInfo[n].rep(r);
-        _NodeSCCAuxInfo[r].addSubNodes(n);
-        if (n != r)
-        {
-            _NodeSCCAuxInfo[n].subNodes().clear();
-            repNodes.reset(n);
-            repNodes.set(r);
-        }
+        return info(n).inSCC;
     }
-
     inline NodeID rep(NodeID n)
     {
-        return _NodeSCCAuxInfo[n].rep();
+        return info(n).rep;
     }
-    inline bool isInSCC(NodeID n)
+    inline NodeID order(NodeID n)
     {
-        return _NodeSCCAuxInfo[n].inSCC();
+        return info(n).d;
     }
 
     inline GNODE Node(NodeID id) const
@@ -246,44 +234,79 @@ private:
         return GTraits::getNodeID(node);
     }
 
-    void visit(NodeID v)
+    void visit(NodeID root)
     {
-        // SVFUtil::outs() << "visit GNODE: " << Node_Index(v)<< "\n";
-        _I += 1;
-        _D[v] = _I;
-        this->rep(v,v);
-        this->setVisited(v,true);
-
-        child_iterator EI = GTraits::direct_child_begin(Node(v));
-        child_iterator EE = GTraits::direct_child_end(Node(v));
-
-        for (; EI != EE; ++EI)
+        enter(root);
+        while (!_dfs.empty())
         {
-            NodeID w = Node_Index(*EI);
-
-            if (!this->visited(w))
-                visit(w);
-            if (!this->inSCC(w))
+            Frame& frame = _dfs.back();
+            if (frame.child != frame.childEnd)
+            {
+                NodeID w = Node_Index(*frame.child);
+                if (!this->visited(w))
+                {
+                    // The edge is handled once w is finished
+                    enter(w);
+                    continue;
+                }
+                updateRep(frame.node, w);
+                ++frame.child;
+            }
+            else
             {
-                NodeID rep;
-                rep = _D[this->rep(v)] < _D[this->rep(w)] ?
-                      this->rep(v) : this->rep(w);
-                this->rep(v,rep);
+                NodeID v = frame.node;
+                _dfs.pop_back();
+                finish(v);
+                if (!_dfs.empty())
+                {
+                    Frame& parent = _dfs.back();
+                    updateRep(parent.node, v);
+                    ++parent.child;
+                }
             }
         }
-        if (this->rep(v) == v)
+    }
+
+    inline void enter(NodeID v)
+    {
+        // SVFUtil::outs() << "visit GNODE: " << v << "\n";
+        markVisited(v).rep = v;
+        GNODE node = Node(v);
+        _dfs.push_back({v, GTraits::direct_child_begin(node), GTraits::direct_child_end(node)});
+    }
+
+    /// After the edge from v to w has been followed
+    inline void updateRep(NodeID v, NodeID w)
+    {
+        if (!this->inSCC(w))
+        {
+            NodeID repV = this->rep(v);
+            NodeID repW = this->rep(w);
+            if (order(repW) <= order(repV))
+                info(v).rep = repW;
+        }
+    }
+
+    void finish(NodeID v)
+    {
+        NodeInfo& vInfo = info(v);
+        if (vInfo.rep == v)
         {
-            this->setInSCC(v,true);
+            vInfo.inSCC = true;
+            vInfo.subNodes.set(v);
             while (!_SS.empty())
             {
                 NodeID w = _SS.top();
-                if (_D[w] <= _D[v])
+                if (order(w) <= vInfo.d)
                     break;
                 else
                 {
                     _SS.pop();
-                    this->setInSCC(w,true);
-                    this->rep(w,v);
+                    NodeInfo& wInfo = info(w);
+                    wInfo.inSCC = true;
+                    wInfo.rep = v;
+                    vInfo.subNodes.set(w);
+                    repNodes.set(v);
                 }
             }
             _T.push(v);
@@ -294,15 +317,181 @@ private:
 
     void clear()
     {
-        _NodeSCCAuxInfo.clear();
+        for (NodeID n : _visitedNodes)
+        {
+            if (n < _info.size())
+            {
+                NodeInfo& nInfo = _info[n];
+                nInfo.d = 0;
+                nInfo.rep = UINT_MAX;
+                nInfo.inSCC = false;
+                nInfo.subNodes.clear();
+            }
+        }
+        _visitedNodes.clear();
+        _farInfo.clear();
+        // Sparse IDs (e.g., from the debug node ID allocation) are not worth a table
+        _denseLimit = std::max(_info.size(), 2 * (size_t)GTraits::graphSize(_graph) + 1024);
         _I = 0;
-        _D.clear();
         repNodes.clear();
         while(!_SS.empty())
             _SS.pop();
         while(!_T.empty())
             _T.pop();
+        _dfs.clear();
     }
+
+    /// Parallel detection
+    //@{
+    /// Nodes are numbered by their position in node iteration order, and components by
+    /// the number of their first node
+    static constexpr u32_t Unassigned = UINT_MAX;
+    /// Trimming stops when a round finds nothing or after this many rounds
+    static constexpr u32_t MaxTrimRounds = 8;
+    /// Below this, loops are not worth threads
+    static constexpr size_t ParallelChunk = 1024;
+
+    /// Adjacency lists of the numbered nodes
+    struct Adjacency
+    {
+        std::vector<u32_t> begin;   ///< n + 1 offsets into nodes
+        std::vector<u32_t> nodes;
+
+        inline const u32_t* from(size_t v) const
+        {
+            return nodes.data() + begin[v];
+        }
+        inline const u32_t* to(size_t v) const
+        {
+            return nodes.data() + begin[v + 1];
+        }
+        inline u32_t degree(size_t v) const
+        {
+            return begin[v + 1] - begin[v];
+        }
+    };
+
+    /// Call f(i, thread) for i in [0, n) on numThreads threads
+    template<typename F>
+    static void parallelFor(u32_t numThreads, size_t n, F f)
+    {
+        if (numThreads <= 1 || n <= ParallelChunk)
+        {
+            for (size_t i = 0; i < n; ++i)
+                f(i, 0);
+            return;
+        }
+
+        std::atomic<size_t> next(0);
+        auto work = [&](u32_t thread)
+        {
+            for (size_t begin = next.fetch_add(ParallelChunk); begin < n; begin = next.fetch_add(ParallelChunk))
+            {
+                size_t end = std::min(n, begin + ParallelChunk);
+                for (size_t i = begin; i < end; ++i)
+                    f(i, thread);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (u32_t t = 1; t < numThreads; ++t)
+            threads.emplace_back(work, t);
+        work(0);
+        for (std::thread& t : threads)
+            t.join();
+    }
+
+    /// Whether v has an edge in adj to another unassigned node
+    static inline bool hasUnassigned(const Adjacency& adj, size_t v, const std::atomic<u32_t>* comp)
+    {
+        for (const u32_t* w = adj.from(v), *e = adj.to(v); w != e; ++w)
+            if (*w != v && comp[*w].load(std::memory_order_relaxed) == Unassigned)
+                return true;
+        return false;
+    }
+
+    /// Mark the unassigned nodes reachable from start in adj, one level at a time
+    static void reach(u32_t numThreads, size_t start, const Adjacency& adj, const std::atomic<u32_t>* comp,
+                      std::atomic<bool>* mark)
+    {
+        mark[start].store(true, std::memory_order_relaxed);
+        std::vector<u32_t> frontier(1, start);
+        std::vector<std::vector<u32_t>> next(numThreads);
+        while (!frontier.empty())
+        {
+            parallelFor(numThreads, frontier.size(), [&](size_t i, u32_t thread)
+            {
+                size_t v = frontier[i];
+                for (const u32_t* w = adj.from(v), *e = adj.to(v); w != e; ++w)
+                {
+                    if (comp[*w].load(std::memory_order_relaxed) == Unassigned &&
+                            !mark[*w].exchange(true, std::memory_order_relaxed))
+                        next[thread].push_back(*w);
+                }
+            });
+            frontier.clear();
+            for (std::vector<u32_t>& nodes : next)
+            {
+                frontier.insert(frontier.end(), nodes.begin(), nodes.end());
+                nodes.clear();
+            }
+        }
+    }
+
+    /// Tarjan's algorithm over the unassigned nodes
+    static void assignRest(const Adjacency& succ, std::atomic<u32_t>* comp)
+    {
+        const size_t n = succ.begin.size() - 1;
+        std::vector<u32_t> index(n, 0), low(n, 0);
+        std::vector<u32_t> stack;
+        std::vector<std::pair<u32_t, u32_t>> dfs;   // node and its next child
+        u32_t counter = 0;
+        for (size_t root = 0; root < n; ++root)
+        {
+            if (comp[root].load(std::memory_order_relaxed) != Unassigned || index[root])
+                continue;
+            index[root] = low[root] = ++counter;
+            stack.push_back(root);
+            dfs.push_back(std::make_pair(root, succ.begin[root]));
+            while (!dfs.empty())
+            {
+                u32_t v = dfs.back().first;
+                u32_t& pos = dfs.back().second;
+                if (pos < succ.begin[v + 1])
+                {
+                    u32_t w = succ.nodes[pos++];
+                    if (comp[w].load(std::memory_order_relaxed) != Unassigned)
+                        continue;
+                    if (!index[w])
+                    {
+                        index[w] = low[w] = ++counter;
+                        stack.push_back(w);
+                        dfs.push_back(std::make_pair(w, succ.begin[w]));
+                    }
+                    else
+                        low[v] = std::min(low[v], index[w]);
+                    continue;
+                }
+
+                dfs.pop_back();
+                if (!dfs.empty())
+                {
+                    u32_t parent = dfs.back().first;
+                    low[parent] = std::min(low[parent], low[v]);
+                }
+                if (low[v] == index[v])
+                {
+                    // Nodes on the stack down to v, numbered by their first one
+                    std::vector<u32_t>::iterator first = std::find(stack.begin(), stack.end(), v);
+                    u32_t rep = *std::min_element(first, stack.end());
+                    for (std::vector<u32_t>::iterator it = first; it != stack.end(); ++it)
+                        comp[*it].store(rep, std::memory_order_relaxed);
+                    stack.erase(first, stack.end());
+                }
+            }
+        }
+    }
+    //@}
+
 public:
 
     void find(void)
@@ -316,18 +505,7 @@ public:
         {
             NodeID node = Node_Index(*I);
             if (!this->visited(node))
-            {
-                // We skip any nodes that have a representative other than
-                // themselves.  Such nodes occur as a result of merging
-                // nodes either through unifying an ACC or other node
-                // merging optimizations.  Any such node should have no
-                // outgoing edges and therefore should no longer be a member
-                // of an SCC.
-                if (this->rep(node) == UINT_MAX || this->rep(node) == node)
-                    visit(node);
-                else
-                    this->visited(node);
-            }
+                visit(node);
         }
     }
 
@@ -338,17 +516,213 @@ public:
         for (NodeID node : candidates)
         {
             if (!this->visited(node))
+                visit(node);
+        }
+    }
+
+    /// find() on numThreads threads: nodes which cannot be in a cycle are trimmed, the
+    /// component of the node with the most paths through it (usually the largest one) is
+    /// found by a forward and a backward search, and the rest by Tarjan's algorithm.
+    /// Components are the same as find()'s, but each is represented by its first node in
+    /// node iteration order and topoNodeStack() may hold another topological order.
+    void findParallel(u32_t numThreads)
+    {
+        if (numThreads <= 1)
+        {
+            find();
+            return;
+        }
+
+        clear();
+        std::vector<NodeID> ids;
+        for (node_iterator I = GTraits::nodes_begin(_graph), E = GTraits::nodes_end(_graph); I != E; ++I)
+        {
+            ids.push_back(Node_Index(*I));
+            markVisited(ids.back());
+        }
+        const size_t n = ids.size();
+
+        // Successors and predecessors of the numbered nodes, whose number is d - 1
+        Adjacency succ, pred;
+        succ.begin.assign(n + 1, 0);
+        parallelFor(numThreads, n, [&](size_t v, u32_t)
+        {
+            GNODE node = Node(ids[v]);
+            succ.begin[v + 1] = std::distance(GTraits::direct_child_begin(node), GTraits::direct_child_end(node));
+        });
+        for (size_t v = 0; v < n; ++v)
+            succ.begin[v + 1] += succ.begin[v];
+        succ.nodes.resize(succ.begin[n]);
+        parallelFor(numThreads, n, [&](size_t v, u32_t)
+        {
+            GNODE node = Node(ids[v]);
+            u32_t pos = succ.begin[v];
+            for (child_iterator EI = GTraits::direct_child_begin(node), EE = GTraits::direct_child_end(node); EI != EE; ++EI)
             {
-                if (this->rep(node) == UINT_MAX || this->rep(node) == node)
-                    visit(node);
-                else
-                    this->visited(node);
+                const NodeInfo* wInfo = getInfo(Node_Index(*EI));
+                assert(wInfo && "edge to a node not in the graph");
+                succ.nodes[pos++] = wInfo->d - 1;
+            }
+        });
+
+        std::unique_ptr<std::atomic<u32_t>[]> cursor(new std::atomic<u32_t>[n + 1]);
+        for (size_t v = 0; v <= n; ++v)
+            cursor[v].store(0, std::memory_order_relaxed);
+        parallelFor(numThreads, n, [&](size_t v, u32_t)
+        {
+            for (const u32_t* w = succ.from(v), *e = succ.to(v); w != e; ++w)
+                cursor[*w + 1].fetch_add(1, std::memory_order_relaxed);
+        });
+        pred.begin.assign(n + 1, 0);
+        for (size_t v = 0; v < n; ++v)
+        {
+            pred.begin[v + 1] = pred.begin[v] + cursor[v + 1].load(std::memory_order_relaxed);
+            cursor[v].store(pred.begin[v], std::memory_order_relaxed);
+        }
+        pred.nodes.resize(pred.begin[n]);
+        parallelFor(numThreads, n, [&](size_t v, u32_t)
+        {
+            for (const u32_t* w = succ.from(v), *e = succ.to(v); w != e; ++w)
+                pred.nodes[cursor[*w].fetch_add(1, std::memory_order_relaxed)] = v;
+        });
+
+        std::unique_ptr<std::atomic<u32_t>[]> comp(new std::atomic<u32_t>[n]);
+        for (size_t v = 0; v < n; ++v)
+            comp[v].store(Unassigned, std::memory_order_relaxed);
+
+        // Nodes without edges from or to other unassigned nodes are components of their own
+        bool trimmed = true;
+        for (u32_t round = 0; trimmed && round < MaxTrimRounds; ++round)
+        {
+            std::atomic<bool> changed(false);
+            parallelFor(numThreads, n, [&](size_t v, u32_t)
+            {
+                if (comp[v].load(std::memory_order_relaxed) == Unassigned &&
+                        (!hasUnassigned(succ, v, comp.get()) || !hasUnassigned(pred, v, comp.get())))
+                {
+                    comp[v].store(v, std::memory_order_relaxed);
+                    changed.store(true, std::memory_order_relaxed);
+                }
+            });
+            trimmed = changed.load();
+        }
+
+        // The component of the pivot are the nodes both reachable from and reaching it
+        size_t pivot = n;
+        u64_t bestPaths = 0;
+        for (size_t v = 0; v < n; ++v)
+        {
+            u64_t paths = (u64_t)succ.degree(v) * pred.degree(v);
+            if (comp[v].load(std::memory_order_relaxed) == Unassigned && paths > bestPaths)
+            {
+                pivot = v;
+                bestPaths = paths;
             }
         }
+        if (pivot != n)
+        {
+            std::unique_ptr<std::atomic<bool>[]> forward(new std::atomic<bool>[n]);
+            std::unique_ptr<std::atomic<bool>[]> backward(new std::atomic<bool>[n]);
+            for (size_t v = 0; v < n; ++v)
+            {
+                forward[v].store(false, std::memory_order_relaxed);
+                backward[v].store(false, std::memory_order_relaxed);
+            }
+            reach(numThreads, pivot, succ, comp.get(), forward.get());
+            reach(numThreads, pivot, pred, comp.get(), backward.get());
+
+            u32_t rep = pivot;
+            for (size_t v = 0; v < pivot; ++v)
+            {
+                if (forward[v].load(std::memory_order_relaxed) && backward[v].load(std::memory_order_relaxed))
+                {
+                    rep = v;
+                    break;
+                }
+            }
+            parallelFor(numThreads, n, [&](size_t v, u32_t)
+            {
+                if (forward[v].load(std::memory_order_relaxed) && backward[v].load(std::memory_order_relaxed))
+                    comp[v].store(rep, std::memory_order_relaxed);
+            });
+        }
+
+        assignRest(succ, comp.get());
+
+        // Members of each component, and the components in topological order (Kahn's)
+        std::vector<u32_t> memberBegin(n + 1, 0), members(n);
+        for (size_t v = 0; v < n; ++v)
+            ++memberBegin[comp[v].load(std::memory_order_relaxed) + 1];
+        for (size_t v = 0; v < n; ++v)
+            memberBegin[v + 1] += memberBegin[v];
+        std::vector<u32_t> fill(memberBegin.begin(), memberBegin.end() - 1);
+        for (size_t v = 0; v < n; ++v)
+            members[fill[comp[v].load(std::memory_order_relaxed)]++] = v;
+
+        std::vector<u32_t> inDegree(n, 0);
+        for (size_t v = 0; v < n; ++v)
+        {
+            u32_t c = comp[v].load(std::memory_order_relaxed);
+            for (const u32_t* w = succ.from(v), *e = succ.to(v); w != e; ++w)
+                if (comp[*w].load(std::memory_order_relaxed) != c)
+                    ++inDegree[comp[*w].load(std::memory_order_relaxed)];
+        }
+        std::vector<u32_t> topoOrder;
+        size_t numComps = 0;
+        for (size_t c = 0; c < n; ++c)
+        {
+            if (memberBegin[c] == memberBegin[c + 1])
+                continue;
+            ++numComps;
+            if (inDegree[c] == 0)
+                topoOrder.push_back(c);
+        }
+        for (size_t i = 0; i < topoOrder.size(); ++i)
+        {
+            u32_t c = topoOrder[i];
+            for (u32_t m = memberBegin[c]; m < memberBegin[c + 1]; ++m)
+            {
+                for (const u32_t* w = succ.from(members[m]), *e = succ.to(members[m]); w != e; ++w)
+                {
+                    u32_t wc = comp[*w].load(std::memory_order_relaxed);
+                    if (wc != c && --inDegree[wc] == 0)
+                        topoOrder.push_back(wc);
+                }
+            }
+        }
+        assert(topoOrder.size() == numComps && "components are not acyclic");
+        (void)numComps;
+
+        for (size_t c = 0; c < n; ++c)
+        {
+            u32_t size = memberBegin[c + 1] - memberBegin[c];
+            if (size == 0)
+                continue;
+            NodeID rep = ids[c];
+            NodeInfo& repInfo = info(rep);
+            for (u32_t m = memberBegin[c]; m < memberBegin[c + 1]; ++m)
+            {
+                NodeInfo& mInfo = info(ids[members[m]]);
+                mInfo.rep = rep;
+                mInfo.inSCC = true;
+                repInfo.subNodes.set(ids[members[m]]);
+            }
+            if (size > 1)
+                repNodes.set(rep);
+        }
+        for (std::vector<u32_t>::reverse_iterator it = topoOrder.rbegin(); it != topoOrder.rend(); ++it)
+            _T.push(ids[*it]);
     }
 
 };
 
+template<class GraphType>
+constexpr u32_t SCCDetection<GraphType>::Unassigned;
+template<class GraphType>
+constexpr u32_t SCCDetection<GraphType>::MaxTrimRounds;
+template<class GraphType>
+constexpr size_t SCCDetection<GraphType>::ParallelChunk;
+
 } // End namespace SVF
 
 #endif /* SCC_H_ */
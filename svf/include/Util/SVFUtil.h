@@ -647,6 +647,8 @@ template <typename T> struct is_map : std::false_type {};
 template <typename... Ts> struct is_map<std::map<Ts...>> : std::true_type {};
 template <typename... Ts>
 struct is_map<std::unordered_map<Ts...>> : std::true_type {};
+template <typename... Ts>
+struct is_map<FlatHashMap<Ts...>> : std::true_type {};
 template <typename... Ts> constexpr bool is_map_v = is_map<Ts...>::value;
 ///@}
 
@@ -656,6 +658,8 @@ template <typename T> struct is_set : std::false_type {};
 template <typename... Ts> struct is_set<std::set<Ts...>> : std::true_type {};
 template <typename... Ts>
 struct is_set<std::unordered_set<Ts...>> : std::true_type {};
+template <typename... Ts>
+struct is_set<FlatHashSet<Ts...>> : std::true_type {};
 template <typename... Ts> constexpr bool is_set_v = is_set<Ts...>::value;
 ///@}
 
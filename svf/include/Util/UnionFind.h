@@ -0,0 +1,233 @@
+//===- UnionFind.h -- Disjoint sets of nodes ---------------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * UnionFind.h
+ *
+ * Disjoint sets of node IDs with union by rank and path compression, used for the
+ * equivalence classes of Steensgaard's analysis and the nodes merged by Andersen's
+ * SCC/PWC and field collapsing. Every node starts in a set of its own.
+ *
+ * The members of a set are also kept on a circular list, which merging splices in
+ * constant time, so member sets are only built when asked for.
+ *
+ * After unite(), a set is represented by the representative of one of the merged
+ * sets, picked by rank. After merge(), it is represented by a node chosen by the caller
+ * (e.g., the constraint node the others were collapsed into).
+ *
+ * Node IDs are allocated upwards from 0 and, with -node-alloc-strat=dense, also
+ * downwards from UINT_MAX (NodeIDAllocator), so the state of nodes is kept in two
+ * arrays growing from either end.
+ */
+
+#ifndef UNIONFIND_H_
+#define UNIONFIND_H_
+
+#include "SVFIR/SVFValue.h"	// for NodeBS
+
+#include <limits.h>
+#include <algorithm>
+#include <vector>
+
+namespace SVF
+{
+
+class UnionFind
+{
+private:
+    struct Entry
+    {
+        NodeID parent;  ///< parent in the tree, the node itself for a root
+        NodeID next;    ///< next member on the circular list of the set
+        NodeID rep;     ///< representative of the set, valid for a root
+        u32_t rank;
+    };
+
+    /// IDs from here on are kept in high, indexed by UINT_MAX - ID
+    static constexpr NodeID highStart = UINT_MAX / 2;
+
+    std::vector<Entry> low;
+    std::vector<Entry> high;
+
+public:
+    /// Representative of the set of n. The tree is not compressed, so this can be
+    /// called concurrently with other const methods.
+    inline NodeID find(NodeID n) const
+    {
+        const Entry* e = getEntry(n);
+        if (e == nullptr)
+            return n;
+        while (e->parent != n)
+        {
+            n = e->parent;
+            e = getEntry(n);
+        }
+        return e->rep;
+    }
+
+    /// Whether n represents its set
+    inline bool isRep(NodeID n) const
+    {
+        return find(n) == n;
+    }
+
+    /// Merge the sets of a and b, return the new representative (the representative
+    /// of either set, picked by rank)
+    NodeID unite(NodeID a, NodeID b)
+    {
+        NodeID rootA = root(a);
+        NodeID rootB = root(b);
+        if (rootA == rootB)
+            return entry(rootA).rep;
+        return entry(link(rootA, rootB)).rep;
+    }
+
+    /// Merge the set of node into the set represented by rep, which keeps representing it
+    void merge(NodeID node, NodeID rep)
+    {
+        assert(isRep(rep) && "merging into a node which does not represent its set");
+        NodeID rootNode = root(node);
+        NodeID rootRep = root(rep);
+        if (rootNode == rootRep)
+            return;
+        NodeID r = link(rootNode, rootRep);
+        entry(r).rep = rep;
+    }
+
+    /// Members of the set represented by rep (including rep)
+    NodeBS members(NodeID rep) const
+    {
+        NodeBS result;
+        result.set(rep);
+        if (const Entry* e = getEntry(rep))
+        {
+            for (NodeID m = e->next; m != rep; m = getEntry(m)->next)
+                result.set(m);
+        }
+        return result;
+    }
+
+    /// Take n out of its set. If n represents the set, every member is left on its own.
+    void isolate(NodeID n)
+    {
+        if (getEntry(n) == nullptr)
+            return;
+
+        std::vector<NodeID> others;
+        for (NodeID m = entry(n).next; m != n; m = entry(m).next)
+            others.push_back(m);
+        NodeID rep = find(n);
+        reset(n);
+        if (others.empty())
+            return;
+
+        if (rep == n)
+        {
+            for (NodeID m : others)
+                reset(m);
+            return;
+        }
+
+        // Rebuild the set of the others as a flat tree
+        NodeID r = others.front();
+        for (size_t i = 0; i < others.size(); ++i)
+        {
+            Entry& e = entry(others[i]);
+            e.parent = r;
+            e.next = others[(i + 1) % others.size()];
+        }
+        Entry& rootEntry = entry(r);
+        rootEntry.rep = rep;
+        rootEntry.rank = others.size() > 1 ? 1 : 0;
+    }
+
+    void clear()
+    {
+        low.clear();
+        high.clear();
+    }
+
+private:
+    inline const Entry* getEntry(NodeID n) const
+    {
+        if (n < highStart)
+            return n < low.size() ? &low[n] : nullptr;
+        NodeID idx = UINT_MAX - n;
+        return idx < high.size() ? &high[idx] : nullptr;
+    }
+
+    /// Entry of n, created if n has none yet. References to entries are invalidated
+    /// when another one is created.
+    Entry& entry(NodeID n)
+    {
+        std::vector<Entry>& entries = n < highStart ? low : high;
+        size_t idx = n < highStart ? n : UINT_MAX - n;
+        if (idx >= entries.size())
+        {
+            size_t oldSize = entries.size();
+            entries.resize(std::max(idx + 1, 2 * oldSize));
+            for (size_t i = oldSize; i < entries.size(); ++i)
+            {
+                NodeID id = n < highStart ? i : UINT_MAX - i;
+                entries[i] = {id, id, id, 0};
+            }
+        }
+        return entries[idx];
+    }
+
+    /// Root of the tree of n, pointing the nodes on the way to their grandparents
+    NodeID root(NodeID n)
+    {
+        NodeID parent = entry(n).parent;
+        while (parent != n)
+        {
+            NodeID grandParent = entry(parent).parent;
+            entry(n).parent = grandParent;
+            n = parent;
+            parent = grandParent;
+        }
+        return n;
+    }
+
+    /// Link two roots by rank, return the new root
+    NodeID link(NodeID rootA, NodeID rootB)
+    {
+        if (entry(rootA).rank < entry(rootB).rank)
+            std::swap(rootA, rootB);
+        Entry& a = entry(rootA);
+        Entry& b = entry(rootB);
+        b.parent = rootA;
+        if (a.rank == b.rank)
+            ++a.rank;
+        std::swap(a.next, b.next);
+        return rootA;
+    }
+
+    void reset(NodeID n)
+    {
+        entry(n) = {n, n, n, 0};
+    }
+};
+
+} // End namespace SVF
+
+#endif /* UNIONFIND_H_ */
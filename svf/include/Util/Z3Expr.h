@@ -38,8 +38,9 @@ namespace SVF
 class Z3Expr
 {
 public:
-    static z3::context *ctx;
-    static z3::solver* solver;
+    /// Each thread owns its context and solver, as z3 objects must not be shared across threads
+    static thread_local z3::context *ctx;
+    static thread_local z3::solver* solver;
 
 private:
     z3::expr e;
@@ -81,10 +82,10 @@ public:
         return e;
     }
 
-    /// Get z3 solver, singleton design here to make sure we only have one context
+    /// Get z3 solver, singleton design here to make sure we only have one context per thread
     static z3::solver &getSolver();
 
-    /// Get z3 context, singleton design here to make sure we only have one context
+    /// Get z3 context, singleton design here to make sure we only have one context per thread
     static z3::context &getContext();
 
     /// release z3 context
@@ -46,6 +46,7 @@ namespace SVF
 {
 
 class SVFModule;
+class AnderIncrementalState;
 
 /*!
  * Abstract class of inclusion-based Pointer Analysis
@@ -73,6 +74,9 @@ public:
 
     virtual void readPtsFromFile(const std::string& filename);
 
+    /// Solve constraints reusing the solution kept in the state file, then update the file
+    virtual void solveIncrementally(const std::string& filename);
+
     virtual void solveConstraints();
 
     /// Initialize analysis
@@ -209,7 +213,7 @@ public:
     {
         return consCG->sccRepNode(id);
     }
-    inline NodeBS& sccSubNodes(NodeID repId)
+    inline NodeBS sccSubNodes(NodeID repId)
     {
         return consCG->sccSubNodes(repId);
     }
@@ -314,6 +318,14 @@ protected:
     /// Update call graph for the input indirect callsites
     virtual bool updateCallGraph(const CallSiteToFunPtrMap& callsites);
 
+    /// Incremental solving (-incremental-ander)
+    //@{
+    virtual void solveIncrementally(const std::string& filename) override;
+    void recordConstraints(AnderIncrementalState& state, bool initial);
+    void recordSolution(AnderIncrementalState& state);
+    void seedFromPreviousSolution(const AnderIncrementalState& prev, const AnderIncrementalState& cur);
+    //@}
+
     /// Connect formal and actual parameters for indirect callsites
     void connectCaller2CalleeParams(CallSite cs, const SVFFunction* F, NodePairSet& cpySrcNodes);
 
@@ -415,6 +427,14 @@ public:
     virtual void postProcessNode(NodeID nodeId);
     virtual bool handleLoad(NodeID id, const ConstraintEdge* load);
     virtual bool handleStore(NodeID id, const ConstraintEdge* store);
+
+protected:
+    /// Parallel wave propagation, used when Options::AnderThreads() > 1
+    //@{
+    void solveWorklistInParallel();
+    void processLevel(const std::vector<NodeID>& level);
+    void postProcessNodes(const std::vector<NodeID>& nodes);
+    //@}
 };
 
 } // End namespace SVF
@@ -9,6 +9,7 @@
 #define INCLUDE_WPA_STEENSGAARD_H_
 
 #include "WPA/Andersen.h"
+#include "Util/UnionFind.h"
 
 namespace SVF
 {
@@ -21,8 +22,6 @@ class Steensgaard : public AndersenBase
 {
 
 public:
-    typedef Map<NodeID, NodeID> NodeToEquivClassMap;
-    typedef Map<NodeID, Set<NodeID>> NodeToSubsMap;
     typedef OrderedMap<CallSite, NodeID> CallSite2DummyValPN;
 
     /// Constructor
@@ -92,22 +91,12 @@ public:
     /// An equivalence class has a set of sub constraint nodes.
     inline NodeID getEC(NodeID id) const
     {
-        NodeToEquivClassMap::const_iterator it = nodeToECMap.find(id);
-        if (it == nodeToECMap.end())
-            return id;
-        else
-            return it->second;
+        return ecs.find(id);
     }
-    void setEC(NodeID node, NodeID rep);
-
-    inline Set<NodeID>& getSubNodes(NodeID id)
-    {
-        nodeToSubsMap[id].insert(id);
-        return nodeToSubsMap[id];
-    }
-    inline void addSubNode(NodeID node, NodeID sub)
+    /// Constraint nodes in the equivalence class represented by id
+    inline NodeBS getSubNodes(NodeID id) const
     {
-        nodeToSubsMap[node].insert(sub);
+        return ecs.members(id);
     }
 
     /// Add copy edge on constraint graph
@@ -132,8 +121,7 @@ protected:
 
 private:
     static Steensgaard* steens; // static instance
-    NodeToEquivClassMap nodeToECMap;
-    NodeToSubsMap nodeToSubsMap;
+    UnionFind ecs;  ///< equivalence classes
 };
 
 } // namespace SVF
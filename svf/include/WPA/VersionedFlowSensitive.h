@@ -100,6 +100,9 @@ protected:
     virtual bool processLoad(const LoadSVFGNode* load) override;
     virtual bool processStore(const StoreSVFGNode* store) override;
     virtual void processNode(NodeID n) override;
+    /// With more than one -vfs-threads, alternates between processing the worklist and
+    /// propagating the versions it changed in parallel, until neither has work left.
+    virtual void solveWorklist() override;
     virtual void updateConnectedNodes(const SVFGEdgeSetTy& newEdges) override;
 
     /// Override to do nothing. Instead, we will use propagateVersion when necessary.
@@ -131,6 +134,12 @@ private:
     /// taken itself.
     void propagateVersion(const NodeID o, const Version v, const Version vp, bool time=true);
 
+    /// Propagates the versions in pendingVersions to the versions which rely on them,
+    /// transitively. Objects are independent of each other here, so each object is one
+    /// task of a work-stealing pool of Options::VFSThreads() threads. Workers only read
+    /// points-to sets; the changes are written back, and reliant statements notified, serially.
+    void propagateVersionsInParallel(void);
+
     /// Fills in isStoreMap and isLoadMap.
     virtual void buildIsStoreLoadMaps(void);
 
@@ -203,6 +212,9 @@ private:
     /// o x version -> statement nodes which rely on that o/version.
     Map<NodeID, Map<Version, NodeBS>> stmtReliance;
 
+    /// Versions which changed but have not been propagated yet (parallel solving only).
+    Map<NodeID, Set<Version>> pendingVersions;
+
     /// Maps an <object, version> pair to the SVFG node indicating that pair
     /// needs to be propagated.
     VarToPropNodeMap versionedVarToPropNode;
@@ -258,6 +270,13 @@ private:
             bool onStack;
         } NodeData;
 
+        /// A node being visited and its next out edge.
+        typedef struct Frame
+        {
+            const SVFGNode *node;
+            SVFGNode::const_iterator edge;
+        } Frame;
+
     public:
         /// Determines the strongly connected components of svfg following only
         /// edges labelled with object. partOf[n] = scc means nodes n is part of
@@ -277,16 +296,18 @@ private:
                                    std::vector<const IndirectSVFGEdge *> &footprint);
 
     private:
-        /// Called by detectSCCs then called recursively.
+        /// Called by detectSCCs for each unvisited starting node, visits
+        /// everything reachable from root using dfs as its stack.
         static void visit(VersionedFlowSensitive *vfs,
                           const NodeID object,
                           std::vector<int> &partOf,
                           std::vector<const IndirectSVFGEdge *> &footprint,
                           std::vector<NodeData> &nodeData,
                           std::stack<const SVFGNode *> &stack,
+                          std::vector<Frame> &dfs,
                           int &index,
                           int &currentSCC,
-                          const SVFGNode *v);
+                          const SVFGNode *root);
     };
 };
 
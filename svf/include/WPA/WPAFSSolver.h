@@ -49,7 +49,7 @@ class WPAFSSolver : public WPASolver<GraphType>
 {
 public:
     /// Constructor
-    WPAFSSolver() : WPASolver<GraphType>()
+    WPAFSSolver() : WPASolver<GraphType>(), sccThreads(1)
     {}
     /// Destructor
     virtual ~WPAFSSolver() {}
@@ -60,14 +60,24 @@ public:
         return id;
     }
 
+    /// Number of threads for SCC detection (1 means sequential)
+    inline void setSCCThreads(u32_t threads)
+    {
+        sccThreads = threads;
+    }
+
 protected:
     NodeStack nodeStack;	///< stack used for processing nodes.
+    u32_t sccThreads;	///< threads for SCC detection.
 
     /// SCC detection
     virtual NodeStack& SCCDetect()
     {
         /// SCC detection
-        this->getSCCDetector()->find();
+        if (sccThreads > 1)
+            this->getSCCDetector()->findParallel(sccThreads);
+        else
+            this->getSCCDetector()->find();
 
         /// Both rep and sub nodes need to be processed later.
         /// Collect sub nodes from SCCDetector.
@@ -209,7 +209,12 @@ void CFLAlias::initialize()
 
 void CFLAlias::initializeSolver()
 {
-    solver = new CFLSolver(graph, grammar);
+    if (Options::CFLBitMatrix())
+        solver = new BitMatrixCFLSolver(graph, grammar);
+    else if (Options::CFLEdgeTriples())
+        solver = new CompactCFLSolver(graph, grammar);
+    else
+        solver = new CFLSolver(graph, grammar);
 }
 
 void CFLAlias::finalize()
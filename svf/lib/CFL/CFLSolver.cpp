@@ -28,6 +28,7 @@
  */
 
 #include "CFL/CFLSolver.h"
+#include "Util/Options.h"
 
 using namespace SVF;
 
@@ -378,4 +379,310 @@ void POCRHybridSolver::meld_h(NodeID x, TreeNode* uNode, TreeNode* vNode)
     {
         meld_h(x, newVNode, vChild);
     }
-}
\ No newline at end of file
+}
+void BitMatrixCFLSolver::initialize()
+{
+    for(const CFLEdge* edge : graph->getCFLEdges())
+    {
+        pushIntoWorklist(edge);
+    }
+
+    /// Foreach production X -> epsilon
+    ///     add X(i,i) if not exist to E and to worklist
+    for(const Production& prod : grammar->getEpsilonProds())
+    {
+        Symbol X = grammar->getLHSSymbol(prod);
+        for(auto it = graph->begin(); it!= graph->end(); it++)
+        {
+            CFLNode* i = (*it).second;
+            pushIntoWorklist(graph->addCFLEdge(i, i, X));
+        }
+    }
+}
+
+bool BitMatrixCFLSolver::hasEdge(NodeID src, NodeID dst, Label X) const
+{
+    SymbolToMatrix::const_iterator it = succs.find(X);
+    if (it == succs.end() || it->second.size() <= src)
+        return false;
+    return it->second[src].test(dst);
+}
+
+void BitMatrixCFLSolver::addEdge(NodeID src, NodeID dst, Label X, SymbolToMatrix& nextDelta)
+{
+    NodeBS dsts;
+    dsts.set(dst);
+    addRow(src, dsts, X, nextDelta);
+}
+
+void BitMatrixCFLSolver::addRow(NodeID src, const NodeBS& dsts, u32_t X, SymbolToMatrix& nextDelta)
+{
+    NodeBS& row = getRow(succs[X], src);
+    NodeBS newDsts;
+    newDsts.intersectWithComplement(dsts, row);
+    if (newDsts.empty())
+        return;
+
+    row |= newDsts;
+    BitMatrix& xPreds = preds[X];
+    for (NodeID dst : newDsts)
+        getRow(xPreds, dst).set(src);
+    getRow(nextDelta[X], src) |= newDsts;
+    getRow(derived[X], src) |= newDsts;
+}
+
+void BitMatrixCFLSolver::applyProductions(const SymbolToMatrix& delta, SymbolToMatrix& nextDelta)
+{
+    for (const SymbolToMatrix::value_type& it : delta)
+    {
+        Symbol Y = it.first;
+        const BitMatrix& deltaY = it.second;
+        for (NodeID i = 0; i < deltaY.size(); ++i)
+        {
+            const NodeBS& row = deltaY[i];
+            if (row.empty())
+                continue;
+
+            /// For each production X -> Y
+            ///     add X(i,j) for each new Y(i,j)
+            if (grammar->hasProdsFromSingleRHS(Y))
+                for (const Production& prod : grammar->getProdsFromSingleRHS(Y))
+                {
+                    numOfChecks += row.count();
+                    addRow(i, row, grammar->getLHSSymbol(prod), nextDelta);
+                }
+
+            /// For each production X -> Y Z
+            ///     add X(i,k) for each new Y(i,j), i.e., OR the Z rows of all j into X row of i
+            if (grammar->hasProdsFromFirstRHS(Y))
+                for (const Production& prod : grammar->getProdsFromFirstRHS(Y))
+                {
+                    const BitMatrix& succsZ = succs[grammar->getSecondRHSSymbol(prod)];
+                    NodeBS dsts;
+                    for (NodeID j : row)
+                    {
+                        if (j < succsZ.size())
+                        {
+                            numOfChecks += succsZ[j].count();
+                            dsts |= succsZ[j];
+                        }
+                    }
+                    addRow(i, dsts, grammar->getLHSSymbol(prod), nextDelta);
+                }
+
+            /// For each production X -> Z Y
+            ///     add X(k,j) for each new Y(i,j) and Z(k,i), i.e., OR the Y row of i into X rows of all k
+            if (grammar->hasProdsFromSecondRHS(Y))
+                for (const Production& prod : grammar->getProdsFromSecondRHS(Y))
+                {
+                    const BitMatrix& predsZ = preds[grammar->getFirstRHSSymbol(prod)];
+                    if (i >= predsZ.size())
+                        continue;
+                    /// Copied as adding rows of X may change the Z predecessors when X == Z
+                    NodeBS srcs = predsZ[i];
+                    for (NodeID k : srcs)
+                    {
+                        numOfChecks += row.count();
+                        addRow(k, row, grammar->getLHSSymbol(prod), nextDelta);
+                    }
+                }
+        }
+    }
+}
+
+void BitMatrixCFLSolver::addDerivedEdges()
+{
+    for (const SymbolToMatrix::value_type& it : derived)
+    {
+        Symbol X = it.first;
+        for (NodeID i = 0; i < it.second.size(); ++i)
+        {
+            for (NodeID k : it.second[i])
+                graph->addCFLEdge(graph->getGNode(i), graph->getGNode(k), X);
+        }
+    }
+    derived.clear();
+}
+
+void BitMatrixCFLSolver::solve()
+{
+    if (!initialized)
+    {
+        initialize();
+        initialized = true;
+    }
+
+    /// Edges pending in the worklist are already in the graph, so the first delta is not derived
+    SymbolToMatrix delta;
+    for (const CFLEdge* edge : pending)
+        addEdge(edge->getSrcID(), edge->getDstID(), Symbol(edge->getEdgeKind()), delta);
+    pending.clear();
+    derived.clear();
+
+    while (!delta.empty())
+    {
+        SymbolToMatrix nextDelta;
+        applyProductions(delta, nextDelta);
+        delta.swap(nextDelta);
+    }
+
+    addDerivedEdges();
+}
+
+const u32_t CompactCFLSolver::emptySlot;
+
+void CompactCFLSolver::initialize()
+{
+    for(const CFLEdge* edge : graph->getCFLEdges())
+    {
+        pushIntoWorklist(edge);
+    }
+    /// Edges loaded so far are already in the graph
+    materialized = arena.size();
+
+    /// Foreach production X -> epsilon
+    ///     add X(i,i) if not exist to the arena
+    for(const Production& prod : grammar->getEpsilonProds())
+    {
+        Symbol X = grammar->getLHSSymbol(prod);
+        for(auto it = graph->begin(); it!= graph->end(); it++)
+        {
+            addEdge(it->first, it->first, X);
+        }
+    }
+}
+
+size_t CompactCFLSolver::findSlot(NodeID src, NodeID dst, u32_t label) const
+{
+    size_t mask = index.size() - 1;
+    for (size_t slot = hashTriple(src, dst, label) & mask; ; slot = (slot + 1) & mask)
+    {
+        u32_t idx = index[slot];
+        if (idx == emptySlot)
+            return slot;
+        const EdgeTriple& triple = arena[idx];
+        if (triple.src == src && triple.dst == dst && triple.label == label)
+            return slot;
+    }
+}
+
+void CompactCFLSolver::growIndex()
+{
+    index.assign(index.empty() ? 1024 : index.size() * 2, emptySlot);
+    for (u32_t idx = 0; idx < arena.size(); ++idx)
+    {
+        const EdgeTriple& triple = arena[idx];
+        index[findSlot(triple.src, triple.dst, triple.label)] = idx;
+    }
+}
+
+bool CompactCFLSolver::hasEdge(NodeID src, NodeID dst, u32_t label) const
+{
+    if (index.empty())
+        return false;
+    return index[findSlot(src, dst, label)] != emptySlot;
+}
+
+bool CompactCFLSolver::addEdge(NodeID src, NodeID dst, u32_t label)
+{
+    /// Keep the load factor of the index table below 1/2
+    if (2 * (arena.size() + 1) > index.size())
+        growIndex();
+
+    size_t slot = findSlot(src, dst, label);
+    if (index[slot] != emptySlot)
+        return false;
+
+    assert(arena.size() < emptySlot && "too many CFL edges for 32-bit arena indices");
+    index[slot] = arena.size();
+    arena.push_back({src, dst, label});
+    u32_t succList = getAdjList(succs, src, label);
+    adjLists[succList].push_back(dst);
+    u32_t predList = getAdjList(preds, dst, label);
+    adjLists[predList].push_back(src);
+    return true;
+}
+
+void CompactCFLSolver::processTriple(const EdgeTriple& triple)
+{
+    Symbol Y = triple.label;
+    NodeID i = triple.src;
+    NodeID j = triple.dst;
+
+    /// For each production X -> Y
+    ///     add X(i,j) if not exist to the arena
+    if (grammar->hasProdsFromSingleRHS(Y))
+        for (const Production& prod : grammar->getProdsFromSingleRHS(Y))
+        {
+            numOfChecks++;
+            addEdge(i, j, grammar->getLHSSymbol(prod));
+        }
+
+    /// For each production X -> Y Z
+    ///     Foreach outgoing edge Z(j,k) from node j do
+    ///         add X(i,k) if not exist to the arena
+    if (grammar->hasProdsFromFirstRHS(Y))
+        for (const Production& prod : grammar->getProdsFromFirstRHS(Y))
+        {
+            AdjacencyMap::const_iterator it = succs.find(getAdjKey(j, grammar->getSecondRHSSymbol(prod)));
+            if (it == succs.end())
+                continue;
+            /// Indexed as adding X edges may grow or move the neighbour lists
+            u32_t succsZ = it->second;
+            u32_t X = grammar->getLHSSymbol(prod);
+            for (size_t n = 0, size = adjLists[succsZ].size(); n < size; ++n)
+            {
+                numOfChecks++;
+                addEdge(i, adjLists[succsZ][n], X);
+            }
+        }
+
+    /// For each production X -> Z Y
+    ///     Foreach incoming edge Z(k,i) to node i do
+    ///         add X(k,j) if not exist to the arena
+    if (grammar->hasProdsFromSecondRHS(Y))
+        for (const Production& prod : grammar->getProdsFromSecondRHS(Y))
+        {
+            AdjacencyMap::const_iterator it = preds.find(getAdjKey(i, grammar->getFirstRHSSymbol(prod)));
+            if (it == preds.end())
+                continue;
+            u32_t predsZ = it->second;
+            u32_t X = grammar->getLHSSymbol(prod);
+            for (size_t n = 0, size = adjLists[predsZ].size(); n < size; ++n)
+            {
+                numOfChecks++;
+                addEdge(adjLists[predsZ][n], j, X);
+            }
+        }
+}
+
+void CompactCFLSolver::addDerivedEdges()
+{
+    /// Clients query the start symbol only, other edges are needed when the graph is dumped
+    bool all = Options::PrintCFL();
+    u32_t startKind = grammar->getStartKind();
+    for (; materialized < arena.size(); ++materialized)
+    {
+        const EdgeTriple& triple = arena[materialized];
+        if (all || triple.label == startKind)
+            graph->addCFLEdge(graph->getGNode(triple.src), graph->getGNode(triple.dst), triple.label);
+    }
+}
+
+void CompactCFLSolver::solve()
+{
+    if (!initialized)
+    {
+        initialize();
+        initialized = true;
+    }
+
+    /// The arena may grow while a triple is processed, so it is copied out first
+    while (!isWorklistEmpty())
+    {
+        EdgeTriple triple = arena[next++];
+        processTriple(triple);
+    }
+
+    addDerivedEdges();
+}
@@ -68,7 +68,12 @@ void CFLVF::initialize()
     normalizeCFLGrammar();
 
     // Initialize solver
-    solver = new CFLSolver(graph, grammar);
+    if (Options::CFLBitMatrix())
+        solver = new BitMatrixCFLSolver(graph, grammar);
+    else if (Options::CFLEdgeTriples())
+        solver = new CompactCFLSolver(graph, grammar);
+    else
+        solver = new CFLSolver(graph, grammar);
 }
 
 void CFLVF::checkParameter()
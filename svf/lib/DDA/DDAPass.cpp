@@ -35,8 +35,14 @@
 #include "DDA/ContextDDA.h"
 #include "DDA/DDAClient.h"
 
+#include <algorithm>
+#include <cstring>
+#include <iostream>
 #include <sstream>
 #include <limits.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -138,7 +144,10 @@ void DDAPass::runPointerAnalysis(SVFIR* pag, u32_t kind)
         ///initialize
         _pta->initialize();
         ///compute points-to
-        _client->answerQueries(_pta.get());
+        if (!Options::DDAServer().empty())
+            serveQueries(Options::DDAServer());
+        else
+            _client->answerQueries(_pta.get());
         ///finalize
         _pta->finalize();
         if(Options::PrintCPts())
@@ -331,3 +340,206 @@ void DDAPass::printQueryPTS()
         _pta->dumpPts(*it,pts);
     }
 }
+
+/*!
+ * Keep the SVFG and the points-to caches of the analysis alive and answer
+ * queries from stdin or from clients of a Unix domain socket. Requests:
+ *   pts <ptr>            points-to set of a pointer
+ *   alias <ptr> <ptr>    alias result of two pointers
+ *   quit                 close the input (or the client connection)
+ *   shutdown             stop the socket server
+ * A pointer is a SVFIR node ID, or the name of a global or of a
+ * function:argument (instructions carry no names in SVFIR).
+ */
+void DDAPass::serveQueries(const std::string& endpoint)
+{
+    if (endpoint == "stdin")
+    {
+        std::string line;
+        bool quit = false;
+        while (!quit && std::getline(std::cin, line))
+        {
+            if (line.empty())
+                continue;
+            outs() << answerQuery(line, quit) << "\n";
+            outs().flush();
+        }
+    }
+    else
+        serveQueriesOnSocket(endpoint);
+}
+
+void DDAPass::serveQueriesOnSocket(const std::string& path)
+{
+    struct sockaddr_un addr;
+    if (path.size() >= sizeof(addr.sun_path))
+    {
+        errs() << "socket path too long: " << path << "\n";
+        return;
+    }
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0)
+    {
+        errs() << "cannot create socket\n";
+        return;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(path.c_str());
+    if (bind(server, (struct sockaddr*) &addr, sizeof(addr)) < 0 || listen(server, 8) < 0)
+    {
+        errs() << "cannot listen on socket " << path << "\n";
+        close(server);
+        return;
+    }
+    outs() << "DDA query server listening on " << path << "\n";
+    outs().flush();
+
+    bool shutdown = false;
+    while (!shutdown)
+    {
+        int client = accept(server, nullptr, nullptr);
+        if (client < 0)
+            break;
+        std::string pending;
+        char buf[4096];
+        bool quit = false;
+        ssize_t n;
+        while (!quit && (n = read(client, buf, sizeof(buf))) > 0)
+        {
+            pending.append(buf, n);
+            size_t eol;
+            while (!quit && (eol = pending.find('\n')) != std::string::npos)
+            {
+                std::string line = pending.substr(0, eol);
+                pending.erase(0, eol + 1);
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                if (line.empty())
+                    continue;
+                if (line == "shutdown")
+                {
+                    shutdown = quit = true;
+                    line = "quit";
+                }
+                std::string reply = answerQuery(line, quit) + "\n";
+                if (write(client, reply.data(), reply.size()) < 0)
+                    quit = true;
+            }
+        }
+        close(client);
+    }
+    close(server);
+    unlink(path.c_str());
+}
+
+/*!
+ * Answer a single request, see serveQueries
+ */
+std::string DDAPass::answerQuery(const std::string& request, bool& quit)
+{
+    std::istringstream ss(request);
+    std::string cmd, p1, p2;
+    ss >> cmd >> p1 >> p2;
+
+    if (cmd == "quit")
+    {
+        quit = true;
+        return "bye";
+    }
+    SVFIR* pag = _pta->getPAG();
+    if (cmd == "pts" && !p1.empty() && p2.empty())
+    {
+        NodeID id;
+        if (!getQueryNode(p1, id))
+            return "error: unknown pointer " + p1;
+        if (!pag->isValidTopLevelPtr(pag->getGNode(id)))
+            return "error: " + p1 + " is not a top-level pointer";
+        PointsTo pts;
+        if (_pta->getAnalysisTy() == PointerAnalysis::Cxt_DDA)
+        {
+            /// conditional points-to sets are only normalized at finalize()
+            ContextDDA* cxtDDA = static_cast<ContextDDA*>(_pta.get());
+            pts = cxtDDA->getBVPointsTo(cxtDDA->computeDDAPts(CxtVar(ContextCond(), id)));
+        }
+        else
+        {
+            _pta->computeDDAPts(id);
+            pts = _pta->getPts(id);
+        }
+        std::string reply = "pts " + std::to_string(id) + " {";
+        for (NodeID o : pts)
+            reply += " " + std::to_string(o);
+        return reply + " }";
+    }
+    if (cmd == "alias" && !p2.empty())
+    {
+        NodeID id1, id2;
+        if (!getQueryNode(p1, id1))
+            return "error: unknown pointer " + p1;
+        if (!getQueryNode(p2, id2))
+            return "error: unknown pointer " + p2;
+        if (!pag->isValidTopLevelPtr(pag->getGNode(id1)) || !pag->isValidTopLevelPtr(pag->getGNode(id2)))
+            return "error: not a top-level pointer";
+        AliasResult result;
+        if (_pta->getAnalysisTy() == PointerAnalysis::Cxt_DDA)
+        {
+            ContextDDA* cxtDDA = static_cast<ContextDDA*>(_pta.get());
+            CxtPtSet cpts1 = cxtDDA->computeDDAPts(CxtVar(ContextCond(), id1));
+            CxtPtSet cpts2 = cxtDDA->computeDDAPts(CxtVar(ContextCond(), id2));
+            result = cxtDDA->alias(cpts1, cpts2);
+        }
+        else
+            result = alias(id1, id2);
+        switch (result)
+        {
+        case AliasResult::NoAlias:
+            return "alias NoAlias";
+        case AliasResult::MustAlias:
+            return "alias MustAlias";
+        case AliasResult::PartialAlias:
+            return "alias PartialAlias";
+        default:
+            return "alias MayAlias";
+        }
+    }
+    return "error: expected 'pts <ptr>', 'alias <ptr> <ptr>' or 'quit'";
+}
+
+/*!
+ * Resolve a pointer given by node ID, global value name or function:value.
+ * Names that are not unique are rejected.
+ */
+bool DDAPass::getQueryNode(const std::string& token, NodeID& id)
+{
+    SVFIR* pag = _pta->getPAG();
+    if (std::all_of(token.begin(), token.end(), ::isdigit))
+    {
+        id = std::stoul(token);
+        return pag->hasGNode(id);
+    }
+
+    if (queryNameToNode.empty())
+    {
+        for (SVFIR::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+        {
+            const SVFVar* var = it->second;
+            if (!SVFUtil::isa<ValVar>(var) || SVFUtil::isa<GepValVar>(var) || !var->hasValue()
+                    || var->getValue()->getName().empty())
+                continue;
+            std::string name = var->getValue()->getName();
+            if (const SVFFunction* fun = var->getFunction())
+                name = fun->getName() + ":" + name;
+            auto res = queryNameToNode.emplace(name, it->first);
+            if (!res.second)
+                res.first->second = UINT_MAX;
+        }
+    }
+
+    Map<std::string, NodeID>::const_iterator it = queryNameToNode.find(token);
+    if (it == queryNameToNode.end() || it->second == UINT_MAX)
+        return false;
+    id = it->second;
+    return true;
+}
@@ -241,7 +241,12 @@ void SVFG::buildSVFG()
         connectIndirectSVFGEdges();
         stat->indVFEdgeEnd();
         if (!Options::WriteSVFG().empty())
-            writeToFile(Options::WriteSVFG());
+        {
+            if (Options::SVFGTextFormat())
+                writeToFile(Options::WriteSVFG());
+            else
+                writeToBinaryFile(Options::WriteSVFG());
+        }
     }
 }
 
@@ -33,6 +33,7 @@
 #include "Graphs/SVFGStat.h"
 #include "MemoryModel/PointerAnalysisImpl.h"
 #include <fstream>
+#include <cstring>
 #include "Util/Options.h"
 
 using namespace SVF;
@@ -206,6 +207,12 @@ void SVFG::writeToFile(const string& filename)
 
 void SVFG::readFile(const string& filename)
 {
+    if (isBinarySVFGFile(filename))
+    {
+        readBinaryFile(filename);
+        return;
+    }
+
     outs() << "Loading SVFG analysis results from '" << filename << "'...";
     ifstream F(filename.c_str());
     if (!F.is_open())
@@ -477,4 +484,414 @@ MRVer* SVFG::getMRVERFromString(const string& s)
     // create mrver
     tempMRVer = new MRVer(tempMemRegion, obj2, tempDef);
     return tempMRVer;
-}
\ No newline at end of file
+}
+
+// Binary format: an 8-byte magic and a u32_t version, followed by a stream of records.
+// Each record starts with a one-byte RecordTag and all its integers are LEB128 varints.
+// A memory region is written once (MRDef) before the first record using it and is
+// referred to by its index afterwards. All node records precede all edge records.
+//   MRDef:          #objs, objs (delta-encoded in ascending order)
+//   MRVer:          mr, version, def type
+//   Formal/Actual*: node id, MRVer, ICFG node id
+//   PHI:            node id, result MRVer, ICFG node id, #operands, operand MRVers
+//   *Edge:          src node id, dst node id [, mr for IndirectEdge]
+namespace
+{
+const char SVFGBinaryMagic[8] = {'S', 'V', 'F', 'G', 'B', 'I', 'N', '\0'};
+const u32_t SVFGBinaryVersion = 1;
+
+enum RecordTag
+{
+    MRDef,
+    FormalINNode,
+    FormalOUTNode,
+    ActualINNode,
+    ActualOUTNode,
+    PHINode,
+    FormalINEdge,
+    FormalOUTRetEdge,
+    FormalOUTIntraEdge,
+    ActualINEdge,
+    IndirectEdge,
+    EndOfRecords = 0xff
+};
+
+class SVFGBinaryWriter
+{
+public:
+    SVFGBinaryWriter(std::ofstream& f) : f(f) {}
+
+    inline void writeTag(RecordTag tag)
+    {
+        f.put(static_cast<char>(tag));
+    }
+
+    inline void writeVarint(u64_t v)
+    {
+        while (v >= 0x80)
+        {
+            f.put(static_cast<char>((v & 0x7f) | 0x80));
+            v >>= 7;
+        }
+        f.put(static_cast<char>(v));
+    }
+
+    /// Return the index of mr, emitting an MRDef record the first time mr is seen.
+    /// Must not be called in the middle of another record.
+    u32_t internMR(const MemRegion* mr)
+    {
+        Map<const MemRegion*, u32_t>::const_iterator it = mrToIdx.find(mr);
+        if (it != mrToIdx.end())
+            return it->second;
+
+        const NodeBS& pts = mr->getPointsTo();
+        writeTag(MRDef);
+        writeVarint(pts.count());
+        NodeID prev = 0;
+        for (NodeID o : pts)
+        {
+            writeVarint(o - prev);
+            prev = o;
+        }
+        u32_t idx = mrToIdx.size();
+        mrToIdx[mr] = idx;
+        return idx;
+    }
+
+    inline void writeMRVer(const MRVer* ver)
+    {
+        writeVarint(mrToIdx.at(ver->getMR()));
+        writeVarint(ver->getSSAVersion());
+        writeVarint(ver->getDef()->getType());
+    }
+
+    void writeNode(RecordTag tag, NodeID id, const MRVer* ver, NodeID icfgId)
+    {
+        internMR(ver->getMR());
+        writeTag(tag);
+        writeVarint(id);
+        writeMRVer(ver);
+        writeVarint(icfgId);
+    }
+
+    void writeEdge(RecordTag tag, NodeID src, NodeID dst)
+    {
+        writeTag(tag);
+        writeVarint(src);
+        writeVarint(dst);
+    }
+
+    void writeIndirectEdge(NodeID src, NodeID dst, const MemRegion* mr)
+    {
+        u32_t mrIdx = internMR(mr);
+        writeEdge(IndirectEdge, src, dst);
+        writeVarint(mrIdx);
+    }
+
+private:
+    std::ofstream& f;
+    Map<const MemRegion*, u32_t> mrToIdx;
+};
+
+class SVFGBinaryReader
+{
+public:
+    SVFGBinaryReader(std::ifstream& f) : f(f) {}
+
+    /// Return the next record tag, or EndOfRecords at the end of the stream
+    inline RecordTag readTag()
+    {
+        int c = f.get();
+        return c == EOF ? EndOfRecords : static_cast<RecordTag>(c);
+    }
+
+    inline u64_t readVarint()
+    {
+        u64_t v = 0;
+        for (u32_t shift = 0; f.good(); shift += 7)
+        {
+            int c = f.get();
+            if (c == EOF)
+                break;
+            v |= static_cast<u64_t>(c & 0x7f) << shift;
+            if (!(c & 0x80))
+                break;
+        }
+        return v;
+    }
+
+    inline NodeID readNodeID()
+    {
+        return static_cast<NodeID>(readVarint());
+    }
+
+    void readMRDef()
+    {
+        NodeBS pts;
+        u64_t num = readVarint();
+        NodeID o = 0;
+        for (u64_t i = 0; i < num; ++i)
+        {
+            o += readNodeID();
+            pts.set(o);
+        }
+        mrs.push_back(new MemRegion(pts));
+    }
+
+    inline const MemRegion* readMR()
+    {
+        u64_t idx = readVarint();
+        assert(idx < mrs.size() && "memory region used before its definition!");
+        return mrs[idx];
+    }
+
+    MRVer* readMRVer()
+    {
+        const MemRegion* mr = readMR();
+        MRVERSION version = readVarint();
+        MSSADEF::DEFTYPE defType = static_cast<MSSADEF::DEFTYPE>(readVarint());
+        return new MRVer(mr, version, new MSSADEF(defType, mr));
+    }
+
+private:
+    std::ifstream& f;
+    std::vector<const MemRegion*> mrs;
+};
+} // End anonymous namespace
+
+bool SVFG::isBinarySVFGFile(const string& filename)
+{
+    ifstream F(filename.c_str(), std::ios_base::binary);
+    char magic[sizeof(SVFGBinaryMagic)];
+    if (!F.read(magic, sizeof(magic)))
+        return false;
+    return memcmp(magic, SVFGBinaryMagic, sizeof(magic)) == 0;
+}
+
+/*!
+ * Write the address-taken nodes and indirect edges of the SVFG in the binary format.
+ * Same content as writeToFile, written in a single streaming pass over the graph.
+ */
+void SVFG::writeToBinaryFile(const string& filename)
+{
+    outs() << "Writing SVFG analysis (binary) to '" << filename << "'...";
+    std::ofstream f(filename.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    if (!f.good())
+    {
+        outs() << "  error opening file for writing!\n";
+        return;
+    }
+    f.write(SVFGBinaryMagic, sizeof(SVFGBinaryMagic));
+    f.write(reinterpret_cast<const char*>(&SVFGBinaryVersion), sizeof(SVFGBinaryVersion));
+
+    SVFGBinaryWriter w(f);
+    for (iterator it = begin(), eit = end(); it != eit; ++it)
+    {
+        NodeID nodeId = it->first;
+        const SVFGNode* node = it->second;
+        if (const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(node))
+            w.writeNode(FormalINNode, nodeId, formalIn->getMRVer(), formalIn->getFunEntryNode()->getId());
+        else if (const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
+            w.writeNode(FormalOUTNode, nodeId, formalOut->getMRVer(), formalOut->getFunExitNode()->getId());
+        else if (const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(node))
+            w.writeNode(ActualINNode, nodeId, actualIn->getMRVer(), actualIn->getCallSite()->getId());
+        else if (const ActualOUTSVFGNode* actualOut = SVFUtil::dyn_cast<ActualOUTSVFGNode>(node))
+            w.writeNode(ActualOUTNode, nodeId, actualOut->getMRVer(), actualOut->getCallSite()->getId());
+        else if (const MSSAPHISVFGNode* phiNode = SVFUtil::dyn_cast<MSSAPHISVFGNode>(node))
+        {
+            for (MemSSA::PHI::OPVers::const_iterator opIt = phiNode->opVerBegin(), opEit = phiNode->opVerEnd();
+                    opIt != opEit; ++opIt)
+                w.internMR(opIt->second->getMR());
+            const SVFInstruction* inst = phiNode->getICFGNode()->getBB()->front();
+            w.writeNode(PHINode, nodeId, phiNode->getResVer(), pag->getICFG()->getICFGNode(inst)->getId());
+            w.writeVarint(std::distance(phiNode->opVerBegin(), phiNode->opVerEnd()));
+            for (MemSSA::PHI::OPVers::const_iterator opIt = phiNode->opVerBegin(), opEit = phiNode->opVerEnd();
+                    opIt != opEit; ++opIt)
+                w.writeMRVer(opIt->second);
+        }
+    }
+
+    for (iterator it = begin(), eit = end(); it != eit; ++it)
+    {
+        NodeID nodeId = it->first;
+        const SVFGNode* node = it->second;
+        if (const LoadSVFGNode* loadNode = SVFUtil::dyn_cast<LoadSVFGNode>(node))
+        {
+            MUSet& muSet = mssa->getMUSet(SVFUtil::cast<LoadStmt>(loadNode->getPAGEdge()));
+            for (MUSet::iterator muIt = muSet.begin(), muEit = muSet.end(); muIt != muEit; ++muIt)
+            {
+                if (LOADMU* mu = SVFUtil::dyn_cast<LOADMU>(*muIt))
+                    w.writeIndirectEdge(nodeId, getDef(mu->getMRVer()), mu->getMRVer()->getMR());
+            }
+        }
+        else if (const StoreSVFGNode* storeNode = SVFUtil::dyn_cast<StoreSVFGNode>(node))
+        {
+            CHISet& chiSet = mssa->getCHISet(SVFUtil::cast<StoreStmt>(storeNode->getPAGEdge()));
+            for (CHISet::iterator chiIt = chiSet.begin(), chiEit = chiSet.end(); chiIt != chiEit; ++chiIt)
+            {
+                if (STORECHI* chi = SVFUtil::dyn_cast<STORECHI>(*chiIt))
+                    w.writeIndirectEdge(nodeId, getDef(chi->getOpVer()), chi->getOpVer()->getMR());
+            }
+        }
+        else if (const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(node))
+        {
+            PTACallGraphEdge::CallInstSet callInstSet;
+            mssa->getPTA()->getPTACallGraph()->getDirCallSitesInvokingCallee(formalIn->getFun(), callInstSet);
+            for (const CallICFGNode* cs : callInstSet)
+            {
+                if (!mssa->hasMU(cs))
+                    continue;
+                for (NodeID actualIn : getActualINSVFGNodes(cs))
+                    w.writeEdge(FormalINEdge, nodeId, actualIn);
+            }
+        }
+        else if (const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
+        {
+            PTACallGraphEdge::CallInstSet callInstSet;
+            mssa->getPTA()->getPTACallGraph()->getDirCallSitesInvokingCallee(formalOut->getFun(), callInstSet);
+            for (const CallICFGNode* cs : callInstSet)
+            {
+                if (!mssa->hasCHI(cs))
+                    continue;
+                for (NodeID actualOut : getActualOUTSVFGNodes(cs))
+                    w.writeEdge(FormalOUTRetEdge, nodeId, actualOut);
+            }
+            w.writeEdge(FormalOUTIntraEdge, nodeId, getDef(formalOut->getMRVer()));
+        }
+        else if (const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(node))
+            w.writeEdge(ActualINEdge, nodeId, getDef(actualIn->getMRVer()));
+        else if (const MSSAPHISVFGNode* phiNode = SVFUtil::dyn_cast<MSSAPHISVFGNode>(node))
+        {
+            for (MemSSA::PHI::OPVers::const_iterator opIt = phiNode->opVerBegin(), opEit = phiNode->opVerEnd();
+                    opIt != opEit; ++opIt)
+                w.writeIndirectEdge(nodeId, getDef(opIt->second), opIt->second->getMR());
+        }
+    }
+    w.writeTag(EndOfRecords);
+
+    f.close();
+    if (f.good())
+        outs() << "\n";
+    else
+        outs() << "  error writing file!\n";
+}
+
+/*!
+ * Read a binary SVFG file written by writeToBinaryFile, one record at a time
+ */
+void SVFG::readBinaryFile(const string& filename)
+{
+    outs() << "Loading SVFG analysis results (binary) from '" << filename << "'...";
+    ifstream F(filename.c_str(), std::ios_base::binary);
+    char magic[sizeof(SVFGBinaryMagic)];
+    u32_t version = 0;
+    if (!F.read(magic, sizeof(magic)) || !F.read(reinterpret_cast<char*>(&version), sizeof(version))
+            || memcmp(magic, SVFGBinaryMagic, sizeof(magic)) != 0 || version != SVFGBinaryVersion)
+    {
+        outs() << " unsupported SVFG file!\n";
+        return;
+    }
+
+    PAGEdge::PAGEdgeSetTy& stores = getPAGEdgeSet(PAGEdge::Store);
+    for (PAGEdge::PAGEdgeSetTy::iterator iter = stores.begin(), eiter = stores.end(); iter != eiter; ++iter)
+    {
+        StoreStmt* store = SVFUtil::cast<StoreStmt>(*iter);
+        const StmtSVFGNode* sNode = getStmtVFGNode(store);
+        for (CHISet::iterator pi = mssa->getCHISet(store).begin(), epi = mssa->getCHISet(store).end(); pi != epi; ++pi)
+            setDef((*pi)->getResVer(), sNode);
+    }
+
+    SVFGBinaryReader r(F);
+    ICFG* icfg = pag->getICFG();
+    bool inEdges = false;
+    stat->ATVFNodeStart();
+    for (RecordTag tag = r.readTag(); tag != EndOfRecords; tag = r.readTag())
+    {
+        if (tag == MRDef)
+        {
+            r.readMRDef();
+            continue;
+        }
+
+        if (!inEdges && tag >= FormalINEdge)
+        {
+            inEdges = true;
+            stat->ATVFNodeEnd();
+            stat->indVFEdgeStart();
+        }
+
+        switch (tag)
+        {
+        case FormalINNode:
+        case FormalOUTNode:
+        case ActualINNode:
+        case ActualOUTNode:
+        case PHINode:
+        {
+            NodeID id = r.readNodeID();
+            MRVer* ver = r.readMRVer();
+            ICFGNode* icfgNode = icfg->getICFGNode(r.readNodeID());
+            if (tag == FormalINNode)
+                addFormalINSVFGNode(SVFUtil::cast<FunEntryICFGNode>(icfgNode), ver, id);
+            else if (tag == FormalOUTNode)
+                addFormalOUTSVFGNode(SVFUtil::cast<FunExitICFGNode>(icfgNode), ver, id);
+            else if (tag == ActualINNode)
+                addActualINSVFGNode(SVFUtil::cast<CallICFGNode>(icfgNode), ver, id);
+            else if (tag == ActualOUTNode)
+                addActualOUTSVFGNode(SVFUtil::cast<CallICFGNode>(icfgNode), ver, id);
+            else
+            {
+                Map<u32_t, const MRVer*> opVers;
+                u64_t numOps = r.readVarint();
+                for (u32_t i = 0; i < numOps; ++i)
+                    opVers[i] = r.readMRVer();
+                addIntraMSSAPHISVFGNode(icfgNode, opVers.begin(), opVers.end(), ver, id);
+            }
+            if (totalVFGNode < id)
+                totalVFGNode = id + 1;
+            break;
+        }
+        case FormalINEdge:
+        {
+            const FormalINSVFGNode* formalIn = SVFUtil::cast<FormalINSVFGNode>(getSVFGNode(r.readNodeID()));
+            const ActualINSVFGNode* actualIn = SVFUtil::cast<ActualINSVFGNode>(getSVFGNode(r.readNodeID()));
+            addInterIndirectVFCallEdge(actualIn, formalIn, getCallSiteID(actualIn->getCallSite(), formalIn->getFun()));
+            break;
+        }
+        case FormalOUTRetEdge:
+        {
+            const FormalOUTSVFGNode* formalOut = SVFUtil::cast<FormalOUTSVFGNode>(getSVFGNode(r.readNodeID()));
+            const ActualOUTSVFGNode* actualOut = SVFUtil::cast<ActualOUTSVFGNode>(getSVFGNode(r.readNodeID()));
+            addInterIndirectVFRetEdge(formalOut, actualOut, getCallSiteID(actualOut->getCallSite(), formalOut->getFun()));
+            break;
+        }
+        case FormalOUTIntraEdge:
+        case ActualINEdge:
+        {
+            NodeID src = r.readNodeID();
+            NodeID dst = r.readNodeID();
+            const MRSVFGNode* mrNode = SVFUtil::cast<MRSVFGNode>(getSVFGNode(src));
+            addIntraIndirectVFEdge(dst, src, mrNode->getPointsTo());
+            break;
+        }
+        case IndirectEdge:
+        {
+            NodeID src = r.readNodeID();
+            NodeID dst = r.readNodeID();
+            addIntraIndirectVFEdge(dst, src, r.readMR()->getPointsTo());
+            break;
+        }
+        default:
+            assert(false && "unknown record in binary SVFG file!");
+            break;
+        }
+    }
+    if (!inEdges)
+    {
+        stat->ATVFNodeEnd();
+        stat->indVFEdgeStart();
+    }
+    stat->indVFEdgeEnd();
+    connectFromGlobalToProgEntry();
+    outs() << "\n";
+}
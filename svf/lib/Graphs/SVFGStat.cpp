@@ -391,30 +391,28 @@ void SVFGStat::performSCCStat(SVFGEdgeSet insensitiveCalRetEdges)
     unsigned retEdgeInCycle = 0;
     unsigned insensitiveRetEdge = 0;
 
-    SVFGSCC* svfgSCC = new SVFGSCC(graph);
+    /// The SVFG is not changed any more, so SCCs are detected on a compact snapshot of it
+    SVFGSnapshot snapshot(graph);
+    SVFGSCC* svfgSCC = new SVFGSCC(&snapshot);
     svfgSCC->find();
 
     NodeSet sccRepNodeSet;
-    SVFG::SVFGNodeIDToNodeMapTy::iterator it = graph->begin();
-    SVFG::SVFGNodeIDToNodeMapTy::iterator eit = graph->end();
-    for (; it != eit; ++it)
+    for (const SVFGSnapshot::NodeType* node : snapshot)
     {
         totalNode++;
-        if(svfgSCC->isInCycle(it->first))
+        if(svfgSCC->isInCycle(node->getId()))
         {
             nodeInCycle++;
-            sccRepNodeSet.insert(svfgSCC->repNode(it->first));
-            const NodeBS& subNodes = svfgSCC->subNodes(it->first);
+            sccRepNodeSet.insert(svfgSCC->repNode(node->getId()));
+            const NodeBS& subNodes = svfgSCC->subNodes(node->getId());
             if(subNodes.count() > maxNodeInCycle)
                 maxNodeInCycle = subNodes.count();
         }
 
-        SVFGEdge::SVFGEdgeSetTy::const_iterator edgeIt = it->second->InEdgeBegin();
-        SVFGEdge::SVFGEdgeSetTy::const_iterator edgeEit = it->second->InEdgeEnd();
-        for (; edgeIt != edgeEit; ++edgeIt)
+        for (const SVFGSnapshot::Adjacency& inEdge : node->getInEdges())
         {
 
-            const SVFGEdge *edge = *edgeIt;
+            const SVFGEdge *edge = inEdge.edge;
             totalEdge++;
             bool eCycle = false;
             if(getSCCRep(svfgSCC,edge->getSrcID()) == getSCCRep(svfgSCC,edge->getDstID()))
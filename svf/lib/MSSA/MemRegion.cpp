@@ -31,10 +31,20 @@
 #include "SVFIR/SVFModule.h"
 #include "MSSA/MemRegion.h"
 #include "MSSA/MSSAMuChi.h"
+#include <atomic>
+#include <thread>
 
 using namespace SVF;
 using namespace SVFUtil;
 
+/// Read-only lookup of the points-to of a callsite, which may be absent
+static inline const NodeBS& getCallSitePts(const MRGenerator::CallSiteToPointsToMap& map, const CallICFGNode* cs)
+{
+    static const NodeBS emptyPts;
+    MRGenerator::CallSiteToPointsToMap::const_iterator it = map.find(cs);
+    return it != map.end() ? it->second : emptyPts;
+}
+
 u32_t MemRegion::totalMRNum = 0;
 u32_t MRVer::totalVERNum = 0;
 
@@ -238,19 +248,49 @@ void MRGenerator::collectModRefForCall()
 
     DBOUT(DGENERAL, outs() << pasMsg("\t\tPerform Callsite Mod-Ref \n"));
 
-    WorkList worklist;
-    getCallGraphSCCRevTopoOrder(worklist);
+    /// SCCs are analysed bottom-up, those of the same level in parallel, and
+    /// their results are merged in order so that they do not depend on threads.
+    std::vector<std::vector<NodeID>> levels;
+    getCallGraphSCCLevels(levels);
 
-    while(!worklist.empty())
+    for (const std::vector<NodeID>& level : levels)
     {
-        NodeID callGraphNodeID = worklist.pop();
-        /// handle all sub scc nodes of this rep node
-        const NodeBS& subNodes = callGraphSCC->subNodes(callGraphNodeID);
-        for(NodeBS::iterator it = subNodes.begin(), eit = subNodes.end(); it!=eit; ++it)
+        std::vector<SCCModRef> sccModRefs(level.size());
+        for (size_t i = 0; i < level.size(); ++i)
+            sccModRefs[i].rep = level[i];
+
+        size_t numThreads = std::min<size_t>(Options::MSSAThreads(), level.size());
+        if (numThreads <= 1)
         {
-            PTACallGraphNode* subCallGraphNode = callGraph->getCallGraphNode(*it);
-            /// Get mod-ref of all callsites calling callGraphNode
-            modRefAnalysis(subCallGraphNode,worklist);
+            for (SCCModRef& sccModRef : sccModRefs)
+                modRefAnalysis(sccModRef);
+        }
+        else
+        {
+            std::atomic<size_t> next(0);
+            auto worker = [this, &sccModRefs, &next]()
+            {
+                for (size_t i = next++; i < sccModRefs.size(); i = next++)
+                    modRefAnalysis(sccModRefs[i]);
+            };
+
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < numThreads; ++t)
+                workers.push_back(std::thread(worker));
+            for (std::thread& w : workers)
+                w.join();
+        }
+
+        for (SCCModRef& sccModRef : sccModRefs)
+        {
+            for (FunToPointsToMap::value_type& it : sccModRef.funToRefs)
+                funToRefsMap[it.first] = std::move(it.second);
+            for (FunToPointsToMap::value_type& it : sccModRef.funToMods)
+                funToModsMap[it.first] = std::move(it.second);
+            for (const CallSiteToPointsToMap::value_type& it : sccModRef.csToRefs)
+                csToRefsMap[it.first] = modRefSets.emplacePts(it.second);
+            for (const CallSiteToPointsToMap::value_type& it : sccModRef.csToMods)
+                csToModsMap[it.first] = modRefSets.emplacePts(it.second);
         }
     }
 
@@ -404,11 +444,7 @@ void MRGenerator::updateAliasMRs()
  */
 void MRGenerator::addRefSideEffectOfFunction(const SVFFunction* fun, const NodeBS& refs)
 {
-    for(NodeBS::iterator it = refs.begin(), eit = refs.end(); it!=eit; ++it)
-    {
-        if(isNonLocalObject(*it,fun))
-            funToRefsMap[fun].set(*it);
-    }
+    addNonLocalObjects(funToRefsMap[fun], refs, fun);
 }
 
 /*!
@@ -416,25 +452,30 @@ void MRGenerator::addRefSideEffectOfFunction(const SVFFunction* fun, const NodeB
  */
 void MRGenerator::addModSideEffectOfFunction(const SVFFunction* fun, const NodeBS& mods)
 {
-    for(NodeBS::iterator it = mods.begin(), eit = mods.end(); it!=eit; ++it)
+    addNonLocalObjects(funToModsMap[fun], mods, fun);
+}
+
+void MRGenerator::addNonLocalObjects(NodeBS& sideEffect, const NodeBS& objs, const SVFFunction* fun) const
+{
+    for(NodeBS::iterator it = objs.begin(), eit = objs.end(); it!=eit; ++it)
     {
         if(isNonLocalObject(*it,fun))
-            funToModsMap[fun].set(*it);
+            sideEffect.set(*it);
     }
 }
 
 /*!
  * Add indirect uses an memory object in the function
  */
-bool MRGenerator::addRefSideEffectOfCallSite(const CallICFGNode* cs, const NodeBS& refs)
+bool MRGenerator::addRefSideEffectOfCallSite(const CallICFGNode* cs, const NodeBS& refs, SCCModRef& sccModRef)
 {
     if(!refs.empty())
     {
         NodeBS refset = refs;
-        refset &= getCallSiteArgsPts(cs);
+        refset &= getCallSitePts(csToCallSiteArgsPtsMap, cs);
         getEscapObjviaGlobals(refset,refs);
-        addRefSideEffectOfFunction(cs->getCaller(),refset);
-        return csToRefsMap[cs] |= refset;
+        addNonLocalObjects(sccModRef.funToRefs[cs->getCaller()],refset,cs->getCaller());
+        return sccModRef.csToRefs[cs] |= refset;
     }
     return false;
 }
@@ -442,32 +483,53 @@ bool MRGenerator::addRefSideEffectOfCallSite(const CallICFGNode* cs, const NodeB
 /*!
  * Add indirect def an memory object in the function
  */
-bool MRGenerator::addModSideEffectOfCallSite(const CallICFGNode* cs, const NodeBS& mods)
+bool MRGenerator::addModSideEffectOfCallSite(const CallICFGNode* cs, const NodeBS& mods, SCCModRef& sccModRef)
 {
     if(!mods.empty())
     {
         NodeBS modset = mods;
-        modset &= (getCallSiteArgsPts(cs) | getCallSiteRetPts(cs));
+        modset &= (getCallSitePts(csToCallSiteArgsPtsMap, cs) | getCallSitePts(csToCallSiteRetPtsMap, cs));
         getEscapObjviaGlobals(modset,mods);
-        addModSideEffectOfFunction(cs->getCaller(),modset);
-        return csToModsMap[cs] |= modset;
+        addNonLocalObjects(sccModRef.funToMods[cs->getCaller()],modset,cs->getCaller());
+        return sccModRef.csToMods[cs] |= modset;
     }
     return false;
 }
 
 
 /*!
- * Get the reverse topo order of scc call graph
+ * Get the levels of call graph sccs, from callees to callers
  */
-void MRGenerator::getCallGraphSCCRevTopoOrder(WorkList& worklist)
+void MRGenerator::getCallGraphSCCLevels(std::vector<std::vector<NodeID>>& levels)
 {
-
-    NodeStack& topoOrder = callGraphSCC->topoNodeStack();
+    /// topoNodeStack pops callers before callees
+    NodeStack topoOrder = callGraphSCC->topoNodeStack();
+    std::vector<NodeID> reps;
     while(!topoOrder.empty())
     {
-        NodeID callgraphNodeID = topoOrder.top();
+        reps.push_back(topoOrder.top());
         topoOrder.pop();
-        worklist.push(callgraphNodeID);
+    }
+
+    Map<NodeID, u32_t> repToLevel;
+    for (std::vector<NodeID>::reverse_iterator rit = reps.rbegin(), reit = reps.rend(); rit != reit; ++rit)
+    {
+        NodeID rep = *rit;
+        u32_t level = 0;
+        for (NodeID sub : callGraphSCC->subNodes(rep))
+        {
+            const PTACallGraphNode* node = callGraph->getCallGraphNode(sub);
+            for (const PTACallGraphEdge* edge : node->getOutEdges())
+            {
+                NodeID calleeRep = callGraphSCC->repNode(edge->getDstID());
+                if (calleeRep != rep)
+                    level = std::max(level, repToLevel[calleeRep] + 1);
+            }
+        }
+        repToLevel[rep] = level;
+        if (levels.size() <= level)
+            levels.resize(level + 1);
+        levels[level].push_back(rep);
     }
 }
 
@@ -598,67 +660,91 @@ bool MRGenerator::isNonLocalObject(NodeID id, const SVFFunction* curFun) const
 /*!
  * Get Mod-Ref of a callee function
  */
-bool MRGenerator::handleCallsiteModRef(NodeBS& mod, NodeBS& ref, const CallICFGNode* cs, const SVFFunction* callee)
+bool MRGenerator::handleCallsiteModRef(NodeBS& mod, NodeBS& ref, const CallICFGNode* cs, const SVFFunction* callee, SCCModRef& sccModRef)
 {
     /// if a callee is a heap allocator function, then its mod set of this callsite is the heap object.
     if(isHeapAllocExtCall(cs->getCallSite()))
     {
-        SVFStmtList& pagEdgeList = getPAGEdgesFromInst(cs->getCallSite());
-        for (SVFStmtList::const_iterator bit = pagEdgeList.begin(),
-                ebit = pagEdgeList.end(); bit != ebit; ++bit)
+        if (hasSVFStmtList(cs->getCallSite()))
         {
-            const PAGEdge* edge = *bit;
-            if (const AddrStmt* addr = SVFUtil::dyn_cast<AddrStmt>(edge))
-                mod.set(addr->getRHSVarID());
+            SVFStmtList& pagEdgeList = getPAGEdgesFromInst(cs->getCallSite());
+            for (SVFStmtList::const_iterator bit = pagEdgeList.begin(),
+                    ebit = pagEdgeList.end(); bit != ebit; ++bit)
+            {
+                const PAGEdge* edge = *bit;
+                if (const AddrStmt* addr = SVFUtil::dyn_cast<AddrStmt>(edge))
+                    mod.set(addr->getRHSVarID());
+            }
         }
     }
     /// otherwise, we find the mod/ref sets from the callee function, who has definition and been processed
+    /// (or is in this scc, whose mod/ref is being computed)
     else
     {
-        mod = getModSideEffectOfFunction(callee);
-        ref = getRefSideEffectOfFunction(callee);
+        const PTACallGraphNode* calleeNode = callGraph->getCallGraphNode(callee);
+        const bool inSCC = callGraphSCC->repNode(calleeNode->getId()) == sccModRef.rep;
+        const FunToPointsToMap& refsMap = inSCC ? sccModRef.funToRefs : funToRefsMap;
+        const FunToPointsToMap& modsMap = inSCC ? sccModRef.funToMods : funToModsMap;
+        FunToPointsToMap::const_iterator refIt = refsMap.find(callee);
+        if (refIt != refsMap.end())
+            ref = refIt->second;
+        FunToPointsToMap::const_iterator modIt = modsMap.find(callee);
+        if (modIt != modsMap.end())
+            mod = modIt->second;
     }
     // add ref set
-    bool refchanged = addRefSideEffectOfCallSite(cs, ref);
+    bool refchanged = addRefSideEffectOfCallSite(cs, ref, sccModRef);
     // add mod set
-    bool modchanged = addModSideEffectOfCallSite(cs, mod);
+    bool modchanged = addModSideEffectOfCallSite(cs, mod, sccModRef);
 
     return refchanged || modchanged;
 }
 
 /*!
  * Call site mod-ref analysis
- * Compute mod-ref of all callsites invoking this call graph node
+ * Compute mod-ref of all callsites in the functions of an scc, iterating until
+ * a fixed point if the functions are recursive
  */
-void MRGenerator::modRefAnalysis(PTACallGraphNode* callGraphNode, WorkList& worklist)
+void MRGenerator::modRefAnalysis(SCCModRef& sccModRef)
 {
-
-    /// add ref/mod set of callee to its invocation callsites at caller
-    for(PTACallGraphNode::iterator it = callGraphNode->InEdgeBegin(), eit = callGraphNode->InEdgeEnd();
-            it!=eit; ++it)
+    const NodeBS& subNodes = callGraphSCC->subNodes(sccModRef.rep);
+    /// start from the mod/ref of the functions collected from their loads/stores
+    for (NodeID sub : subNodes)
     {
-        PTACallGraphEdge* edge = *it;
+        const SVFFunction* fun = callGraph->getCallGraphNode(sub)->getFunction();
+        FunToPointsToMap::const_iterator refIt = funToRefsMap.find(fun);
+        sccModRef.funToRefs[fun] = refIt != funToRefsMap.end() ? refIt->second : NodeBS();
+        FunToPointsToMap::const_iterator modIt = funToModsMap.find(fun);
+        sccModRef.funToMods[fun] = modIt != funToModsMap.end() ? modIt->second : NodeBS();
+    }
 
-        /// handle direct callsites
-        for(PTACallGraphEdge::CallInstSet::iterator cit = edge->getDirectCalls().begin(),
-                ecit = edge->getDirectCalls().end(); cit!=ecit; ++cit)
-        {
-            NodeBS mod, ref;
-            const CallICFGNode* cs = (*cit);
-            bool modrefchanged = handleCallsiteModRef(mod, ref, cs, callGraphNode->getFunction());
-            if(modrefchanged)
-                worklist.push(edge->getSrcID());
-        }
-        /// handle indirect callsites
-        for(PTACallGraphEdge::CallInstSet::iterator cit = edge->getIndirectCalls().begin(),
-                ecit = edge->getIndirectCalls().end(); cit!=ecit; ++cit)
+    const bool inCycle = callGraphSCC->isInCycle(sccModRef.rep);
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (NodeID sub : subNodes)
         {
-            NodeBS mod, ref;
-            const CallICFGNode* cs = (*cit);
-            bool modrefchanged = handleCallsiteModRef(mod, ref, cs, callGraphNode->getFunction());
-            if(modrefchanged)
-                worklist.push(edge->getSrcID());
+            /// add ref/mod set of callees to their invocation callsites at this caller
+            for (const PTACallGraphEdge* edge : callGraph->getCallGraphNode(sub)->getOutEdges())
+            {
+                const SVFFunction* callee = edge->getDstNode()->getFunction();
+                /// handle direct callsites
+                for (const CallICFGNode* cs : edge->getDirectCalls())
+                {
+                    NodeBS mod, ref;
+                    changed |= handleCallsiteModRef(mod, ref, cs, callee, sccModRef);
+                }
+                /// handle indirect callsites
+                for (const CallICFGNode* cs : edge->getIndirectCalls())
+                {
+                    NodeBS mod, ref;
+                    changed |= handleCallsiteModRef(mod, ref, cs, callee, sccModRef);
+                }
+            }
         }
+        /// callees out of a non-recursive scc have been analysed, so one pass suffices
+        changed &= inCycle;
     }
 }
 
@@ -31,6 +31,8 @@
 #include "MSSA/MemPartition.h"
 #include "MSSA/MemSSA.h"
 #include "Graphs/SVFGStat.h"
+#include <atomic>
+#include <thread>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -78,41 +80,130 @@ SVFIR* MemSSA::getPAG()
  */
 void MemSSA::buildMemSSA(const SVFFunction& fun)
 {
+    FunSSA ssa(&fun);
+    buildFunSSA(ssa);
+    mergeFunSSA(ssa);
+}
+
+/*!
+ * Build memory SSA of functions in parallel.
+ * Each function is built into its own FunSSA by whichever thread takes it; FunSSAs
+ * are merged in the order of functions afterwards, so that versions are numbered as
+ * if the functions were built one after another.
+ */
+void MemSSA::buildMemSSA(const std::vector<const SVFFunction*>& funs)
+{
+    size_t numThreads = std::min<size_t>(Options::MSSAThreads(), funs.size());
+    if (numThreads <= 1)
+    {
+        for (const SVFFunction* fun : funs)
+            buildMemSSA(*fun);
+        return;
+    }
+
+    // ICFG nodes of instructions are created on demand, so do it beforehand.
+    ICFG* icfg = pta->getPAG()->getICFG();
+    for (const SVFFunction* fun : funs)
+    {
+        for (const SVFBasicBlock* bb : fun->getReachableBBs())
+        {
+            for (const SVFInstruction* inst : bb->getInstructionList())
+                icfg->getICFGNode(inst);
+        }
+    }
+
+    std::vector<std::unique_ptr<FunSSA>> funSSAs(funs.size());
+    std::atomic<size_t> next(0);
+    auto worker = [this, &funs, &funSSAs, &next]()
+    {
+        for (size_t i = next++; i < funs.size(); i = next++)
+        {
+            funSSAs[i] = std::make_unique<FunSSA>(funs[i]);
+            buildFunSSA(*funSSAs[i]);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < numThreads; ++t)
+        workers.push_back(std::thread(worker));
+    for (std::thread& w : workers)
+        w.join();
+
+    for (std::unique_ptr<FunSSA>& ssa : funSSAs)
+        mergeFunSSA(*ssa);
+}
+
+/*!
+ * Build memory SSA of a function, which only reads MemSSA
+ */
+void MemSSA::buildFunSSA(FunSSA& ssa)
+{
+    const SVFFunction& fun = *ssa.fun;
 
     assert(!isExtCall(&fun) && "we do not build memory ssa for external functions");
 
     DBOUT(DMSSA, outs() << "Building Memory SSA for function " << fun.getName()
           << " \n");
 
-    usedRegs.clear();
-    reg2BBMap.clear();
-
     /// Create mus/chis for loads/stores/calls for memory regions
     double muchiStart = stat->getClk(true);
-    createMUCHI(fun);
+    createMUCHI(ssa);
     double muchiEnd = stat->getClk(true);
-    timeOfCreateMUCHI += (muchiEnd - muchiStart)/TIMEINTERVAL;
+    ssa.timeOfCreateMUCHI += (muchiEnd - muchiStart)/TIMEINTERVAL;
 
     /// Insert PHI for memory regions
     double phiStart = stat->getClk(true);
-    insertPHI(fun);
+    insertPHI(ssa);
     double phiEnd = stat->getClk(true);
-    timeOfInsertingPHI += (phiEnd - phiStart)/TIMEINTERVAL;
+    ssa.timeOfInsertingPHI += (phiEnd - phiStart)/TIMEINTERVAL;
 
     /// SSA rename for memory regions
     double renameStart = stat->getClk(true);
-    SSARename(fun);
+    SSARename(ssa);
     double renameEnd = stat->getClk(true);
-    timeOfSSARenaming += (renameEnd - renameStart)/TIMEINTERVAL;
+    ssa.timeOfSSARenaming += (renameEnd - renameStart)/TIMEINTERVAL;
+
+}
+
+/*!
+ * Merge the memory SSA of a function and assign IDs to its versions
+ */
+void MemSSA::mergeFunSSA(FunSSA& ssa)
+{
+    for (LoadToMUSetMap::value_type& it : ssa.load2MuSetMap)
+        load2MuSetMap[it.first].insert(it.second.begin(), it.second.end());
+    for (StoreToChiSetMap::value_type& it : ssa.store2ChiSetMap)
+        store2ChiSetMap[it.first].insert(it.second.begin(), it.second.end());
+    for (CallSiteToMUSetMap::value_type& it : ssa.callsiteToMuSetMap)
+        callsiteToMuSetMap[it.first].insert(it.second.begin(), it.second.end());
+    for (CallSiteToCHISetMap::value_type& it : ssa.callsiteToChiSetMap)
+        callsiteToChiSetMap[it.first].insert(it.second.begin(), it.second.end());
+    for (BBToPhiSetMap::value_type& it : ssa.bb2PhiSetMap)
+        bb2PhiSetMap[it.first].insert(it.second.begin(), it.second.end());
+    for (FunToEntryChiSetMap::value_type& it : ssa.funToEntryChiSetMap)
+        funToEntryChiSetMap[it.first].insert(it.second.begin(), it.second.end());
+    for (FunToReturnMuSetMap::value_type& it : ssa.funToReturnMuSetMap)
+        funToReturnMuSetMap[it.first].insert(it.second.begin(), it.second.end());
+
+    for (std::unique_ptr<MRVer>& mrVer : ssa.mrVers)
+    {
+        mrVer->vid = MRVer::totalVERNum++;
+        usedMRVers.push_back(std::move(mrVer));
+    }
+    ssa.mrVers.clear();
 
+    timeOfCreateMUCHI += ssa.timeOfCreateMUCHI;
+    timeOfInsertingPHI += ssa.timeOfInsertingPHI;
+    timeOfSSARenaming += ssa.timeOfSSARenaming;
 }
 
 /*!
  * Create mu/chi according to memory regions
  * collect used mrs in usedRegs and construction map from region to BB for prune SSA phi insertion
  */
-void MemSSA::createMUCHI(const SVFFunction& fun)
+void MemSSA::createMUCHI(FunSSA& ssa)
 {
+    const SVFFunction& fun = *ssa.fun;
 
     SVFIR* pag = pta->getPAG();
 
@@ -141,7 +232,7 @@ void MemSSA::createMUCHI(const SVFFunction& fun)
             iter != eiter; ++iter)
     {
         const SVFBasicBlock* bb = *iter;
-        varKills.clear();
+        ssa.varKills.clear();
         for (SVFBasicBlock::const_iterator it = bb->begin(), eit = bb->end(); it != eit; ++it)
         {
             const SVFInstruction* inst = *it;
@@ -153,43 +244,49 @@ void MemSSA::createMUCHI(const SVFFunction& fun)
                 {
                     const PAGEdge* inst = *bit;
                     if (const LoadStmt* load = SVFUtil::dyn_cast<LoadStmt>(inst))
-                        AddLoadMU(bb, load, mrGen->getLoadMRSet(load));
+                    {
+                        if (mrGen->hasLoadMRSet(load))
+                            ssa.AddLoadMU(bb, load, mrGen->getLoadMRSet(load));
+                    }
                     else if (const StoreStmt* store = SVFUtil::dyn_cast<StoreStmt>(inst))
-                        AddStoreCHI(bb, store, mrGen->getStoreMRSet(store));
+                    {
+                        if (mrGen->hasStoreMRSet(store))
+                            ssa.AddStoreCHI(bb, store, mrGen->getStoreMRSet(store));
+                    }
                 }
             }
             if (isNonInstricCallSite(inst))
             {
                 const CallICFGNode* cs = pag->getICFG()->getCallICFGNode(inst);
                 if(mrGen->hasRefMRSet(cs))
-                    AddCallSiteMU(cs,mrGen->getCallSiteRefMRSet(cs));
+                    ssa.AddCallSiteMU(cs,mrGen->getCallSiteRefMRSet(cs));
 
                 if(mrGen->hasModMRSet(cs))
-                    AddCallSiteCHI(cs,mrGen->getCallSiteModMRSet(cs));
+                    ssa.AddCallSiteCHI(cs,mrGen->getCallSiteModMRSet(cs));
             }
         }
     }
 
     // create entry chi for this function including all memory regions
     // initialize them with version 0 and 1 r_1 = chi (r_0)
-    for (MRSet::iterator iter = usedRegs.begin(), eiter = usedRegs.end();
+    for (MRSet::iterator iter = ssa.usedRegs.begin(), eiter = ssa.usedRegs.end();
             iter != eiter; ++iter)
     {
         const MemRegion* mr = *iter;
         // initialize mem region version and stack for renaming phase
-        mr2CounterMap[mr] = 0;
-        mr2VerStackMap[mr].clear();
+        ssa.mr2CounterMap[mr] = 0;
+        ssa.mr2VerStackMap[mr].clear();
         ENTRYCHI* chi = new ENTRYCHI(&fun, mr);
-        chi->setOpVer(newSSAName(mr,chi));
-        chi->setResVer(newSSAName(mr,chi));
-        funToEntryChiSetMap[&fun].insert(chi);
+        chi->setOpVer(ssa.newSSAName(mr,chi));
+        chi->setResVer(ssa.newSSAName(mr,chi));
+        ssa.funToEntryChiSetMap[&fun].insert(chi);
 
         /// if the function does not have a reachable return instruction from function entry
         /// then we won't create return mu for it
         if(!fun.isNotRetFunction())
         {
             RETMU* mu = new RETMU(&fun, mr);
-            funToReturnMuSetMap[&fun].insert(mu);
+            ssa.funToReturnMuSetMap[&fun].insert(mu);
         }
 
     }
@@ -199,8 +296,9 @@ void MemSSA::createMUCHI(const SVFFunction& fun)
 /*
  * Insert phi node
  */
-void MemSSA::insertPHI(const SVFFunction& fun)
+void MemSSA::insertPHI(FunSSA& ssa)
 {
+    const SVFFunction& fun = *ssa.fun;
 
     DBOUT(DMSSA,
           outs() << "\t insert phi for function " << fun.getName() << "\n");
@@ -210,12 +308,12 @@ void MemSSA::insertPHI(const SVFFunction& fun)
     BBToMRSetMap bb2MRSetMap;
 
     // start inserting phi node
-    for (MRSet::iterator iter = usedRegs.begin(), eiter = usedRegs.end();
+    for (MRSet::iterator iter = ssa.usedRegs.begin(), eiter = ssa.usedRegs.end();
             iter != eiter; ++iter)
     {
         const MemRegion* mr = *iter;
 
-        BBList bbs = reg2BBMap[mr];
+        BBList bbs = ssa.reg2BBMap[mr];
         while (!bbs.empty())
         {
             const SVFBasicBlock* bb = bbs.back();
@@ -234,7 +332,7 @@ void MemSSA::insertPHI(const SVFFunction& fun)
                 {
                     bb2MRSetMap[pbb].insert(mr);
                     // insert phi node
-                    AddMSSAPHI(pbb,mr);
+                    ssa.AddMSSAPHI(pbb,mr);
                     // continue to insert phi in its iterative dominate frontiers
                     bbs.push_back(pbb);
                 }
@@ -247,20 +345,21 @@ void MemSSA::insertPHI(const SVFFunction& fun)
 /*!
  * SSA construction algorithm
  */
-void MemSSA::SSARename(const SVFFunction& fun)
+void MemSSA::SSARename(FunSSA& ssa)
 {
+    const SVFFunction& fun = *ssa.fun;
 
     DBOUT(DMSSA,
           outs() << "\t ssa rename for function " << fun.getName() << "\n");
 
-    SSARenameBB(*fun.getEntryBlock());
+    SSARenameBB(*fun.getEntryBlock(), ssa);
 }
 
 /*!
  * Renaming for each memory regions
  * See the renaming algorithm in book Engineering A Compiler (Figure 9.12)
  */
-void MemSSA::SSARenameBB(const SVFBasicBlock& bb)
+void MemSSA::SSARenameBB(const SVFBasicBlock& bb, FunSSA& ssa)
 {
 
     SVFIR* pag = pta->getPAG();
@@ -270,8 +369,9 @@ void MemSSA::SSARenameBB(const SVFBasicBlock& bb)
     // rename phi result op
     // for each r = phi (...)
     // 		rewrite r as new name
-    if (hasPHISet(&bb))
-        RenamePhiRes(getPHISet(&bb),memRegs);
+    BBToPhiSetMap::iterator phiIt = ssa.bb2PhiSetMap.find(&bb);
+    if (phiIt != ssa.bb2PhiSetMap.end())
+        ssa.RenamePhiRes(phiIt->second,memRegs);
 
 
     // process mu and chi
@@ -293,10 +393,10 @@ void MemSSA::SSARenameBB(const SVFBasicBlock& bb)
             {
                 const PAGEdge* inst = *bit;
                 if (const LoadStmt* load = SVFUtil::dyn_cast<LoadStmt>(inst))
-                    RenameMuSet(getMUSet(load));
+                    ssa.RenameMuSet(ssa.load2MuSetMap[load]);
 
                 else if (const StoreStmt* store = SVFUtil::dyn_cast<StoreStmt>(inst))
-                    RenameChiSet(getCHISet(store),memRegs);
+                    ssa.RenameChiSet(ssa.store2ChiSetMap[store],memRegs);
 
             }
         }
@@ -304,15 +404,15 @@ void MemSSA::SSARenameBB(const SVFBasicBlock& bb)
         {
             const CallICFGNode* cs = pag->getICFG()->getCallICFGNode(inst);
             if(mrGen->hasRefMRSet(cs))
-                RenameMuSet(getMUSet(cs));
+                ssa.RenameMuSet(ssa.callsiteToMuSetMap[cs]);
 
             if(mrGen->hasModMRSet(cs))
-                RenameChiSet(getCHISet(cs),memRegs);
+                ssa.RenameChiSet(ssa.callsiteToChiSetMap[cs],memRegs);
         }
         else if(inst->isRetInst())
         {
             const SVFFunction* fun = bb.getParent();
-            RenameMuSet(getReturnMuSet(fun));
+            ssa.RenameMuSet(ssa.funToReturnMuSetMap[fun]);
         }
     }
 
@@ -321,8 +421,9 @@ void MemSSA::SSARenameBB(const SVFBasicBlock& bb)
     for (const SVFBasicBlock* succ : bb.getSuccessors())
     {
         u32_t pos = bb.getBBPredecessorPos(succ);
-        if (hasPHISet(succ))
-            RenamePhiOps(getPHISet(succ),pos,memRegs);
+        BBToPhiSetMap::iterator succPhiIt = ssa.bb2PhiSetMap.find(succ);
+        if (succPhiIt != ssa.bb2PhiSetMap.end())
+            ssa.RenamePhiOps(succPhiIt->second,pos,memRegs);
     }
 
     // for succ basic block in dominator tree
@@ -334,7 +435,7 @@ void MemSSA::SSARenameBB(const SVFBasicBlock& bb)
         const Set<const SVFBasicBlock*>& dtBBs = mapIter->second;
         for (const SVFBasicBlock* dtbb : dtBBs)
         {
-            SSARenameBB(*dtbb);
+            SSARenameBB(*dtbb, ssa);
         }
     }
     // for each r = chi(..), and r = phi(..)
@@ -343,12 +444,12 @@ void MemSSA::SSARenameBB(const SVFBasicBlock& bb)
     {
         const MemRegion* mr = memRegs.back();
         memRegs.pop_back();
-        mr2VerStackMap[mr].pop_back();
+        ssa.mr2VerStackMap[mr].pop_back();
     }
 
 }
 
-MRVer* MemSSA::newSSAName(const MemRegion* mr, MSSADEF* def)
+MRVer* MemSSA::FunSSA::newSSAName(const MemRegion* mr, MSSADEF* def)
 {
     assert(0 != mr2CounterMap.count(mr)
            && "did not find initial version in map? ");
@@ -357,10 +458,11 @@ MRVer* MemSSA::newSSAName(const MemRegion* mr, MSSADEF* def)
 
     MRVERSION version = mr2CounterMap[mr];
     mr2CounterMap[mr] = version + 1;
-    auto mrVer = std::make_unique<MRVer>(mr, version, def);
+    // The ID is assigned by mergeFunSSA.
+    auto mrVer = std::make_unique<MRVer>(mr, version, def, 0);
     auto mrVerPtr = mrVer.get();
     mr2VerStackMap[mr].push_back(mrVerPtr);
-    usedMRVers.push_back(std::move(mrVer));
+    mrVers.push_back(std::move(mrVer));
     return mrVerPtr;
 }
 
@@ -29,6 +29,7 @@
 #include "Util/Options.h"
 #include "SVFIR/SVFModule.h"
 #include "Util/SVFUtil.h"
+#include "Util/PhaseStat.h"
 #include "MSSA/MemSSA.h"
 #include "Graphs/SVFG.h"
 #include "MSSA/SVFGBuilder.h"
@@ -66,6 +67,7 @@ SVFG* SVFGBuilder::build(BVDataPTAImpl* pta, VFG::VFGK kind)
 
     auto mssa = buildMSSA(pta, (VFG::PTRONLYSVFG==kind || VFG::PTRONLYSVFG_OPT==kind));
 
+    PhaseStat::Scope phase("SVFG");
     DBOUT(DGENERAL, outs() << pasMsg("Build Sparse Value-Flow Graph \n"));
     if(kind == VFG::FULLSVFG_OPT || kind == VFG::PTRONLYSVFG_OPT)
         svfg = std::make_unique<SVFGOPT>(std::move(mssa), kind);
@@ -97,11 +99,13 @@ void SVFGBuilder::releaseMemory()
 std::unique_ptr<MemSSA> SVFGBuilder::buildMSSA(BVDataPTAImpl* pta, bool ptrOnlyMSSA)
 {
 
+    PhaseStat::Scope phase("MemSSA");
     DBOUT(DGENERAL, outs() << pasMsg("Build Memory SSA \n"));
 
     auto mssa = std::make_unique<MemSSA>(pta, ptrOnlyMSSA);
 
     SVFModule* svfModule = mssa->getPTA()->getModule();
+    std::vector<const SVFFunction*> funs;
     for (SVFModule::const_iterator iter = svfModule->begin(), eiter = svfModule->end();
             iter != eiter; ++iter)
     {
@@ -110,8 +114,9 @@ std::unique_ptr<MemSSA> SVFGBuilder::buildMSSA(BVDataPTAImpl* pta, bool ptrOnlyM
         if (isExtCall(fun))
             continue;
 
-        mssa->buildMemSSA(*fun);
+        funs.push_back(fun);
     }
+    mssa->buildMemSSA(funs);
 
     mssa->performStat();
     if (Options::DumpMSSA())
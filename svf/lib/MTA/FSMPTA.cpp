@@ -32,6 +32,8 @@
 #include "MTA/MHP.h"
 #include "MTA/PCG.h"
 #include "MemoryModel/PointsTo.h"
+#include <atomic>
+#include <thread>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -492,7 +494,11 @@ void MTASVFGBuilder::handleStoreLoad(const StmtSVFGNode* n1,const StmtSVFGNode*
     if (ADDEDGE_NOALIAS!=Options::AddModelFlag() && !pta->alias(n1->getPAGDstNodeID(), n2->getPAGSrcNodeID()))
         return;
 
+    addStoreLoadEdges(n1, n2, pta);
+}
 
+void MTASVFGBuilder::addStoreLoadEdges(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta)
+{
     PointsTo pts = pta->getPts(n1->getPAGDstNodeID());
     pts &= pta->getPts(n2->getPAGSrcNodeID());
 
@@ -502,7 +508,7 @@ void MTASVFGBuilder::handleStoreLoad(const StmtSVFGNode* n1,const StmtSVFGNode*
     /// This constraint is too strong. All cxt lock under different cxt cannot be identified.
 
 
-    if (ADDEDGE_NOLOCK!=Options::AddModelFlag() && lockana->isProtectedByCommonLock(i1, i2))
+    if (ADDEDGE_NOLOCK!=Options::AddModelFlag() && lockana->isProtectedByCommonLock(n1->getInst(), n2->getInst()))
     {
         if (isTailofSpan(n1) && isHeadofSpan(n2))
             addTDEdges(n1->getId(), n2->getId(), pts);
@@ -526,11 +532,16 @@ void MTASVFGBuilder::handleStoreStore(const StmtSVFGNode* n1,const StmtSVFGNode*
     if (ADDEDGE_NOALIAS!=Options::AddModelFlag() && !pta->alias(n1->getPAGDstNodeID(), n2->getPAGDstNodeID()))
         return;
 
+    addStoreStoreEdges(n1, n2, pta);
+}
+
+void MTASVFGBuilder::addStoreStoreEdges(const StmtSVFGNode* n1,const StmtSVFGNode* n2, PointerAnalysis* pta)
+{
     PointsTo pts = pta->getPts(n1->getPAGDstNodeID());
     pts &= pta->getPts(n2->getPAGDstNodeID());
 
     /// Lock
-    if (ADDEDGE_NOLOCK!=Options::AddModelFlag() && lockana->isProtectedByCommonLock(i1, i2))
+    if (ADDEDGE_NOLOCK!=Options::AddModelFlag() && lockana->isProtectedByCommonLock(n1->getInst(), n2->getInst()))
     {
         if (isTailofSpan(n1) && isHeadofSpan(n2))
             addTDEdges(n1->getId(), n2->getId(), pts);
@@ -714,55 +725,63 @@ void MTASVFGBuilder::connectMHPEdges(PointerAnalysis* pta)
     recordedges.clear();
     edge2pts.clear();
 
-    /// todo: we ignore rule 2 and 3. but so far I haven't added intra-thread value flow affected by fork
-    /// and inter-thread value flow affected by join
-    for (SVFGNodeSet::const_iterator it1 = stnodeSet.begin(), eit1 =  stnodeSet.end(); it1!=eit1; ++it1)
+    BVDataPTAImpl* bvpta = SVFUtil::dyn_cast<BVDataPTAImpl>(pta);
+    if (bvpta && ADDEDGE_NONSPARSE!=Options::AddModelFlag() && ADDEDGE_NOALIAS!=Options::AddModelFlag())
     {
-        const StmtSVFGNode* n1 = SVFUtil::cast<StmtSVFGNode>(*it1);
-        const SVFInstruction* i1 = n1->getInst();
-
-        for (SVFGNodeSet::const_iterator it2 = ldnodeSet.begin(), eit2 = ldnodeSet.end(); it2 != eit2; ++it2)
+        connectMHPEdgesByObjects(bvpta);
+    }
+    else
+    {
+        /// todo: we ignore rule 2 and 3. but so far I haven't added intra-thread value flow affected by fork
+        /// and inter-thread value flow affected by join
+        for (SVFGNodeSet::const_iterator it1 = stnodeSet.begin(), eit1 =  stnodeSet.end(); it1!=eit1; ++it1)
         {
-            const StmtSVFGNode* n2 = SVFUtil::cast<StmtSVFGNode>(*it2);
-            const SVFInstruction* i2 = n2->getInst();
-            if (ADDEDGE_NONSPARSE==Options::AddModelFlag())
+            const StmtSVFGNode* n1 = SVFUtil::cast<StmtSVFGNode>(*it1);
+            const SVFInstruction* i1 = n1->getInst();
+
+            for (SVFGNodeSet::const_iterator it2 = ldnodeSet.begin(), eit2 = ldnodeSet.end(); it2 != eit2; ++it2)
             {
-                if (Options::UsePCG())
+                const StmtSVFGNode* n2 = SVFUtil::cast<StmtSVFGNode>(*it2);
+                const SVFInstruction* i2 = n2->getInst();
+                if (ADDEDGE_NONSPARSE==Options::AddModelFlag())
                 {
-                    if (pcg->mayHappenInParallel(i1, i2) || mhp->mayHappenInParallel(i1, i2))
+                    if (Options::UsePCG())
+                    {
+                        if (pcg->mayHappenInParallel(i1, i2) || mhp->mayHappenInParallel(i1, i2))
+                            handleStoreLoadNonSparse(n1, n2, pta);
+                    }
+                    else
+                    {
                         handleStoreLoadNonSparse(n1, n2, pta);
+                    }
                 }
                 else
                 {
-                    handleStoreLoadNonSparse(n1, n2, pta);
+                    handleStoreLoad(n1, n2, pta);
                 }
             }
-            else
-            {
-                handleStoreLoad(n1, n2, pta);
-            }
-        }
 
-        for (SVFGNodeSet::const_iterator it2 = std::next(it1), eit2 =  stnodeSet.end(); it2!=eit2; ++it2)
-        {
-            const StmtSVFGNode* n2 = SVFUtil::cast<StmtSVFGNode>(*it2);
-            const SVFInstruction* i2 = n2->getInst();
-            if (ADDEDGE_NONSPARSE == Options::AddModelFlag())
+            for (SVFGNodeSet::const_iterator it2 = std::next(it1), eit2 =  stnodeSet.end(); it2!=eit2; ++it2)
             {
-                if (Options::UsePCG())
+                const StmtSVFGNode* n2 = SVFUtil::cast<StmtSVFGNode>(*it2);
+                const SVFInstruction* i2 = n2->getInst();
+                if (ADDEDGE_NONSPARSE == Options::AddModelFlag())
                 {
-                    if(pcg->mayHappenInParallel(i1, i2) || mhp->mayHappenInParallel(i1, i2))
+                    if (Options::UsePCG())
+                    {
+                        if(pcg->mayHappenInParallel(i1, i2) || mhp->mayHappenInParallel(i1, i2))
+                            handleStoreStoreNonSparse(n1, n2, pta);
+                    }
+                    else
+                    {
                         handleStoreStoreNonSparse(n1, n2, pta);
+                    }
                 }
                 else
                 {
-                    handleStoreStoreNonSparse(n1, n2, pta);
+                    handleStoreStore(n1, n2, pta);
                 }
             }
-            else
-            {
-                handleStoreStore(n1, n2, pta);
-            }
         }
     }
 
@@ -774,6 +793,141 @@ void MTASVFGBuilder::connectMHPEdges(PointerAnalysis* pta)
     }
 }
 
+/*!
+ * Index stores and loads by the (field-expanded) objects their pointers may point to, so that
+ * only pairs sharing an object, i.e., pairs for which pta->alias holds, are candidates.
+ * The MHP checks of the candidates are independent and run in parallel, while the lock checks
+ * (which cache lock span heads/tails) and edge adding are done sequentially.
+ */
+void MTASVFGBuilder::connectMHPEdgesByObjects(BVDataPTAImpl* pta)
+{
+    auto idLess = [](const SVFGNode* n1, const SVFGNode* n2)
+    {
+        return n1->getId() < n2->getId();
+    };
+    SVFGNodeVec stores(stnodeSet.begin(), stnodeSet.end());
+    SVFGNodeVec loads(ldnodeSet.begin(), ldnodeSet.end());
+    std::sort(stores.begin(), stores.end(), idLess);
+    std::sort(loads.begin(), loads.end(), idLess);
+
+    /// Object -> indices of the stores/loads which may access it
+    Map<NodeID, NodeBS> objToStores;
+    Map<NodeID, NodeBS> objToLoads;
+    /// Accessed objects of each store; stores/loads through a pointer to the black hole alias everything
+    std::vector<PointsTo> storeObjs(stores.size());
+    NodeBS blackHoleStores;
+    NodeBS blackHoleLoads;
+    for (u32_t i = 0; i < stores.size(); ++i)
+    {
+        const StmtSVFGNode* n = SVFUtil::cast<StmtSVFGNode>(stores[i]);
+        pta->expandFIObjs(pta->getPts(n->getPAGDstNodeID()), storeObjs[i]);
+        if (pta->containBlackHoleNode(storeObjs[i]))
+            blackHoleStores.set(i);
+        for (NodeID o : storeObjs[i])
+            objToStores[o].set(i);
+    }
+    for (u32_t i = 0; i < loads.size(); ++i)
+    {
+        const StmtSVFGNode* n = SVFUtil::cast<StmtSVFGNode>(loads[i]);
+        PointsTo objs;
+        pta->expandFIObjs(pta->getPts(n->getPAGSrcNodeID()), objs);
+        if (pta->containBlackHoleNode(objs))
+            blackHoleLoads.set(i);
+        for (NodeID o : objs)
+            objToLoads[o].set(i);
+    }
+
+    /// todo: we ignore rule 2 and 3. but so far I haven't added intra-thread value flow affected by fork
+    /// and inter-thread value flow affected by join
+    std::vector<StmtNodePair> stLdPairs;
+    std::vector<StmtNodePair> stStPairs;
+    for (u32_t i = 0; i < stores.size(); ++i)
+    {
+        NodeBS ldCands = blackHoleLoads;
+        NodeBS stCands = blackHoleStores;
+        if (blackHoleStores.test(i))
+        {
+            for (u32_t j = 0; j < loads.size(); ++j)
+                ldCands.set(j);
+            for (u32_t j = i + 1; j < stores.size(); ++j)
+                stCands.set(j);
+        }
+        else
+        {
+            for (NodeID o : storeObjs[i])
+            {
+                Map<NodeID, NodeBS>::const_iterator lit = objToLoads.find(o);
+                if (lit != objToLoads.end())
+                    ldCands |= lit->second;
+                stCands |= objToStores[o];
+            }
+        }
+
+        const StmtSVFGNode* n1 = SVFUtil::cast<StmtSVFGNode>(stores[i]);
+        for (NodeID j : ldCands)
+            stLdPairs.push_back(std::make_pair(n1, SVFUtil::cast<StmtSVFGNode>(loads[j])));
+        for (NodeID j : stCands)
+        {
+            if (j > i)
+                stStPairs.push_back(std::make_pair(n1, SVFUtil::cast<StmtSVFGNode>(stores[j])));
+        }
+    }
+
+    filterMHPPairs(stLdPairs);
+    filterMHPPairs(stStPairs);
+
+    for (const StmtNodePair& pair : stLdPairs)
+        addStoreLoadEdges(pair.first, pair.second, pta);
+    for (const StmtNodePair& pair : stStPairs)
+        addStoreStoreEdges(pair.first, pair.second, pta);
+}
+
+void MTASVFGBuilder::filterMHPPairs(std::vector<StmtNodePair>& pairs)
+{
+    if (ADDEDGE_NOMHP==Options::AddModelFlag())
+        return;
+
+    std::vector<bool> isMHP(pairs.size());
+    /// Each thread writes its own chunk of flags so that no two threads share a word of isMHP
+    auto checkRange = [this, &pairs, &isMHP](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+            isMHP[i] = mhp->mayHappenInParallelInstReadOnly(pairs[i].first->getInst(), pairs[i].second->getInst());
+    };
+
+    const size_t chunkSize = 4096;
+    size_t numOfChunks = (pairs.size() + chunkSize - 1) / chunkSize;
+    u32_t numThreads = Options::TDEdgeThreads();
+    if (numThreads <= 1 || numOfChunks <= 1)
+    {
+        checkRange(0, pairs.size());
+    }
+    else
+    {
+        std::atomic<size_t> next(0);
+        auto worker = [&checkRange, &pairs, &next, numOfChunks]()
+        {
+            for (size_t c = next++; c < numOfChunks; c = next++)
+                checkRange(c * chunkSize, std::min((c + 1) * chunkSize, pairs.size()));
+        };
+
+        std::vector<std::thread> workers;
+        for (u32_t t = 0; t < numThreads; ++t)
+            workers.push_back(std::thread(worker));
+        for (std::thread& w : workers)
+            w.join();
+    }
+
+    size_t numOfMHP = 0;
+    for (size_t i = 0; i < pairs.size(); ++i)
+    {
+        if (isMHP[i])
+            pairs[numOfMHP++] = pairs[i];
+    }
+    mhp->recordQueries(pairs.size(), numOfMHP);
+    pairs.resize(numOfMHP);
+}
+
 /*!
  * Initialize analysis
  */
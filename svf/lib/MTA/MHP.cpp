@@ -577,6 +577,36 @@ bool MHP::mayHappenInParallelInst(const SVFInstruction* i1, const SVFInstruction
     return false;
 }
 
+bool MHP::mayHappenInParallelInstReadOnly(const SVFInstruction* i1, const SVFInstruction* i2) const
+{
+    InstToThreadStmtSetMap::const_iterator it1 = instToTSMap.find(i1);
+    InstToThreadStmtSetMap::const_iterator it2 = instToTSMap.find(i2);
+    if (it1 == instToTSMap.end() || it2 == instToTSMap.end())
+        return false;
+
+    NodeBS empty;
+    for (const CxtThreadStmt& ts1 : it1->second)
+    {
+        ThreadStmtToThreadInterleav::const_iterator lit1 = threadStmtToTheadInterLeav.find(ts1);
+        const NodeBS& l1 = lit1 != threadStmtToTheadInterLeav.end() ? lit1->second : empty;
+        for (const CxtThreadStmt& ts2 : it2->second)
+        {
+            if (ts1.getTid() != ts2.getTid())
+            {
+                ThreadStmtToThreadInterleav::const_iterator lit2 = threadStmtToTheadInterLeav.find(ts2);
+                const NodeBS& l2 = lit2 != threadStmtToTheadInterLeav.end() ? lit2->second : empty;
+                if (l1.test(ts2.getTid()) && l2.test(ts1.getTid()))
+                    return true;
+            }
+            else if (tct->getTCTNode(ts1.getTid())->isMultiforked())
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 bool MHP::mayHappenInParallelCache(const SVFInstruction* i1, const SVFInstruction* i2)
 {
     if (!tct->isCandidateFun(i1->getParent()->getParent()) && !tct->isCandidateFun(i2->getParent()->getParent()))
@@ -37,6 +37,7 @@
 #include "WPA/Andersen.h"
 #include "MTA/FSMPTA.h"
 #include "Util/SVFUtil.h"
+#include "Util/PhaseStat.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -112,6 +113,7 @@ bool MTA::runOnModule(SVFIR* pag)
  */
 LockAnalysis* MTA::computeLocksets(TCT* tct)
 {
+    PhaseStat::Scope phase("LockAnalysis");
     LockAnalysis* lsa = new LockAnalysis(tct);
     lsa->analyze();
     return lsa;
@@ -129,7 +131,10 @@ MHP* MTA::computeMHP(SVFModule* module)
     DBOUT(DGENERAL, outs() << pasMsg("Build TCT\n"));
     DBOUT(DMTA, outs() << pasMsg("Build TCT\n"));
     DOTIMESTAT(double tctStart = stat->getClk());
-    tct = std::make_unique<TCT>(pta);
+    {
+        PhaseStat::Scope phase("TCT");
+        tct = std::make_unique<TCT>(pta);
+    }
     tcg = tct->getThreadCallGraph();
     DOTIMESTAT(double tctEnd = stat->getClk());
     DOTIMESTAT(stat->TCTTime += (tctEnd - tctStart) / TIMEINTERVAL);
@@ -146,6 +151,7 @@ MHP* MTA::computeMHP(SVFModule* module)
     DBOUT(DMTA, outs() << pasMsg("MHP analysis\n"));
 
     DOTIMESTAT(double mhpStart = stat->getClk());
+    PhaseStat::Scope phase("MHP");
     MHP* mhp = new MHP(tct.get());
     mhp->analyze();
     DOTIMESTAT(double mhpEnd = stat->getClk());
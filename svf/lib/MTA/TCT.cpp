@@ -496,11 +496,11 @@ void TCT::dumpCxt(CallStrCxt& cxt)
     std::string str;
     std::stringstream rawstr(str);
     rawstr << "[:";
-    for(CallStrCxt::const_iterator it = cxt.begin(), eit = cxt.end(); it!=eit; ++it)
+    for(CallSiteID csId : cxt.toVector())
     {
-        rawstr << " ' "<< *it << " ' ";
-        rawstr << tcg->getCallSite(*it)->getCallSite()->toString();
-        rawstr << "  call  " << tcg->getCallSite(*it)->getCaller()->getName() << "-->" << tcg->getCalleeOfCallSite(*it)->getName() << ", \n";
+        rawstr << " ' "<< csId << " ' ";
+        rawstr << tcg->getCallSite(csId)->getCallSite()->toString();
+        rawstr << "  call  " << tcg->getCallSite(csId)->getCaller()->getName() << "-->" << tcg->getCalleeOfCallSite(csId)->getName() << ", \n";
     }
     rawstr << " ]";
     outs() << "max cxt = " << cxt.size() << rawstr.str() << "\n";
@@ -34,6 +34,11 @@
 #include "Util/CppUtil.h"
 #include <fstream>
 #include <sstream>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -44,7 +49,7 @@ using namespace std;
  * Constructor
  */
 BVDataPTAImpl::BVDataPTAImpl(SVFIR* p, PointerAnalysis::PTATY type, bool alias_check) :
-    PointerAnalysis(p, type, alias_check), ptCache()
+    PointerAnalysis(p, type, alias_check), ptCache(), nextPtsGC(0)
 {
     if (type == Andersen_BASE || type == Andersen_WPA || type == AndersenWaveDiff_WPA
             || type == TypeCPP_WPA || type == FlowS_DDA
@@ -87,9 +92,54 @@ BVDataPTAImpl::BVDataPTAImpl(SVFIR* p, PointerAnalysis::PTATY type, bool alias_c
     }
     else assert(false && "no points-to data available");
 
+    if (Options::ptDataBacking() == PTBackingType::Persistent)
+    {
+        nextPtsGC = Options::PtsGCThreshold();
+        ptCache.setOpCacheLimit(Options::PtsOpCacheLimit());
+    }
+
     ptaImplTy = BVDataImpl;
 }
 
+/*!
+ * Call f on every points-to ID held by the persistent PTData ptD.
+ */
+template <typename F>
+static void visitPersistentPtsIds(BVDataPTAImpl::PTDataTy* ptD, F f)
+{
+    if (BVDataPTAImpl::PersPTDataTy* pers = SVFUtil::dyn_cast<BVDataPTAImpl::PersPTDataTy>(ptD))
+        pers->visitPtsIds(f);
+    else if (BVDataPTAImpl::PersDiffPTDataTy* persDiff = SVFUtil::dyn_cast<BVDataPTAImpl::PersDiffPTDataTy>(ptD))
+        persDiff->visitPtsIds(f);
+    else if (BVDataPTAImpl::PersDFPTDataTy* persDF = SVFUtil::dyn_cast<BVDataPTAImpl::PersDFPTDataTy>(ptD))
+        persDF->visitPtsIds(f);
+    else if (BVDataPTAImpl::PersVersionedPTDataTy* persVersioned = SVFUtil::dyn_cast<BVDataPTAImpl::PersVersionedPTDataTy>(ptD))
+        persVersioned->visitPtsIds(f);
+    else assert(false && "visitPersistentPtsIds: not a persistent PTData!");
+}
+
+/*!
+ * Free the points-to sets of the persistent cache which ptD no longer refers to,
+ * and renumber the IDs ptD holds accordingly.
+ */
+void BVDataPTAImpl::collectPtsGarbage(void)
+{
+    std::vector<bool> live(ptCache.getNumPts(), false);
+    visitPersistentPtsIds(ptD.get(), [&live](PointsToID &id)
+    {
+        live[id] = true;
+    });
+
+    const std::vector<PointsToID> newIds = ptCache.collectGarbage(live);
+    visitPersistentPtsIds(ptD.get(), [&newIds](PointsToID &id)
+    {
+        id = newIds[id];
+    });
+
+    // Collect again once the cache has doubled, so collection stays linear in the sets created.
+    nextPtsGC = std::max<size_t>(Options::PtsGCThreshold(), 2 * ptCache.getNumPts());
+}
+
 void BVDataPTAImpl::finalize()
 {
     normalizePointsTo();
@@ -398,12 +448,14 @@ void BVDataPTAImpl::readAndSetObjFieldSensitivity(std::ifstream& F, const std::s
 }
 
 /*!
- * Load pointer analysis result form a file.
+ * Load pointer analysis result form a file (text or binary).
  * It populates BVDataPTAImpl with the points-to data, and updates SVFIR with
  * the SVFIR offset nodes created during Andersen's solving stage.
  */
 bool BVDataPTAImpl::readFromFile(const string& filename)
 {
+    if (isBinaryPtsFile(filename))
+        return readFromBinaryFile(filename);
 
     outs() << "Loading pointer analysis results from '" << filename << "'...";
 
@@ -431,6 +483,263 @@ bool BVDataPTAImpl::readFromFile(const string& filename)
     return true;
 }
 
+/*
+ * Layout of the binary points-to file. All sections are arrays of fixed-size
+ * integers in host byte order, each starting at an 8-byte aligned offset, so
+ * the file can be mapped and read in place:
+ *
+ *   BinaryPtsHeader
+ *   u64_t  setOffsets[numSets + 1]  offsets of each set into setElems
+ *   NodeID setElems[numSetElems]    elements of all distinct non-empty points-to sets
+ *   NodeID nodeToSet[numNodes]      set ID of each SVFIR node, EmptySetID if none
+ *   BinaryGepObj gepObjs[numGepObjs]
+ *   NodeID fiObjs[numFIObjs]        base objects that are field-insensitive
+ */
+namespace
+{
+const char BinaryPtsMagic[8] = {'S', 'V', 'F', 'P', 'T', 'S', 'B', '\0'};
+const u32_t BinaryPtsVersion = 1;
+const u32_t EmptySetID = UINT32_MAX;
+
+struct BinaryPtsHeader
+{
+    char magic[8];
+    u32_t version;
+    u32_t numSets;
+    u32_t numNodes;
+    u32_t numGepObjs;
+    u32_t numFIObjs;
+    u32_t reserved;
+    u64_t numSetElems;
+};
+
+struct BinaryGepObj
+{
+    NodeID base;
+    NodeID id;
+    APOffset offset;
+};
+
+inline u64_t alignTo8(u64_t offset)
+{
+    return (offset + 7) & ~(u64_t)7;
+}
+
+/// Offsets of each section in a binary points-to file
+struct BinaryPtsSections
+{
+    u64_t setOffsets;
+    u64_t setElems;
+    u64_t nodeToSet;
+    u64_t gepObjs;
+    u64_t fiObjs;
+    u64_t end;
+
+    BinaryPtsSections(const BinaryPtsHeader& h)
+    {
+        setOffsets = alignTo8(sizeof(BinaryPtsHeader));
+        setElems = alignTo8(setOffsets + sizeof(u64_t) * ((u64_t)h.numSets + 1));
+        nodeToSet = alignTo8(setElems + sizeof(NodeID) * h.numSetElems);
+        gepObjs = alignTo8(nodeToSet + sizeof(NodeID) * (u64_t)h.numNodes);
+        fiObjs = alignTo8(gepObjs + sizeof(BinaryGepObj) * (u64_t)h.numGepObjs);
+        end = fiObjs + sizeof(NodeID) * (u64_t)h.numFIObjs;
+    }
+};
+
+template<typename T>
+void writeSection(std::ofstream& f, u64_t offset, const std::vector<T>& data)
+{
+    f.seekp(offset);
+    if (!data.empty())
+        f.write(reinterpret_cast<const char*>(data.data()), sizeof(T) * data.size());
+}
+} // End anonymous namespace
+
+bool BVDataPTAImpl::isBinaryPtsFile(const std::string& filename)
+{
+    ifstream F(filename.c_str(), std::ios_base::binary);
+    char magic[sizeof(BinaryPtsMagic)];
+    if (!F.read(magic, sizeof(magic)))
+        return false;
+    return memcmp(magic, BinaryPtsMagic, sizeof(magic)) == 0;
+}
+
+/*!
+ * Store pointer analysis result into a binary file.
+ * Each distinct points-to set is stored once and nodes refer to it by its index.
+ */
+void BVDataPTAImpl::writeToBinaryFile(const std::string& filename)
+{
+    outs() << "Storing pointer analysis results (binary) to '" << filename << "'...";
+
+    std::ofstream f(filename.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    if (!f.good())
+    {
+        outs() << "  error opening file for writing!\n";
+        return;
+    }
+
+    NodeID maxNodeId = 0;
+    for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
+        maxNodeId = std::max(maxNodeId, it->first);
+
+    // Deduplicate points-to sets
+    Map<PointsTo, u32_t> ptsToSetId;
+    std::vector<u64_t> setOffsets(1, 0);
+    std::vector<NodeID> setElems;
+    std::vector<NodeID> nodeToSet(maxNodeId + 1, EmptySetID);
+    for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
+    {
+        const PointsTo& pts = getPts(it->first);
+        if (pts.empty())
+            continue;
+
+        auto inserted = ptsToSetId.emplace(pts, setOffsets.size() - 1);
+        if (inserted.second)
+        {
+            for (NodeID o : pts)
+                setElems.push_back(o);
+            setOffsets.push_back(setElems.size());
+        }
+        nodeToSet[it->first] = inserted.first->second;
+    }
+
+    std::vector<BinaryGepObj> gepObjs;
+    const SVFIR::NodeOffsetMap& gepObjVarMap = pag->getGepObjNodeMap();
+    for (SVFIR::NodeOffsetMap::const_iterator it = gepObjVarMap.begin(), eit = gepObjVarMap.end(); it != eit; ++it)
+        gepObjs.push_back({it->first.first, it->second, it->first.second});
+
+    NodeBS baseObjs;
+    std::vector<NodeID> fiObjs;
+    for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
+    {
+        if (!isa<ObjVar>(it->second)) continue;
+        NodeID n = pag->getBaseObjVar(it->first);
+        if (baseObjs.test(n)) continue;
+        baseObjs.set(n);
+        if (isFieldInsensitive(n))
+            fiObjs.push_back(n);
+    }
+
+    BinaryPtsHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BinaryPtsMagic, sizeof(BinaryPtsMagic));
+    header.version = BinaryPtsVersion;
+    header.numSets = setOffsets.size() - 1;
+    header.numNodes = nodeToSet.size();
+    header.numGepObjs = gepObjs.size();
+    header.numFIObjs = fiObjs.size();
+    header.numSetElems = setElems.size();
+
+    BinaryPtsSections sections(header);
+    f.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeSection(f, sections.setOffsets, setOffsets);
+    writeSection(f, sections.setElems, setElems);
+    writeSection(f, sections.nodeToSet, nodeToSet);
+    writeSection(f, sections.gepObjs, gepObjs);
+    writeSection(f, sections.fiObjs, fiObjs);
+
+    f.close();
+    if (f.good())
+        outs() << "\n";
+    else
+        outs() << "  error writing file!\n";
+}
+
+/*!
+ * Load pointer analysis result from a binary file written by writeToBinaryFile.
+ * The file is mapped into memory and read in place; each distinct points-to
+ * set is only materialized once.
+ */
+bool BVDataPTAImpl::readFromBinaryFile(const std::string& filename)
+{
+    outs() << "Loading pointer analysis results (binary) from '" << filename << "'...";
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || (u64_t)st.st_size < sizeof(BinaryPtsHeader))
+    {
+        if (fd >= 0) close(fd);
+        outs() << "  error opening file for reading!\n";
+        return false;
+    }
+
+    void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+    {
+        outs() << "  error mapping file!\n";
+        return false;
+    }
+
+    const char* base = static_cast<const char*>(addr);
+    const BinaryPtsHeader* header = reinterpret_cast<const BinaryPtsHeader*>(base);
+    BinaryPtsSections sections(*header);
+    if (memcmp(header->magic, BinaryPtsMagic, sizeof(BinaryPtsMagic)) != 0
+            || header->version != BinaryPtsVersion || sections.end > (u64_t)st.st_size)
+    {
+        munmap(addr, st.st_size);
+        outs() << "  unsupported or truncated file!\n";
+        return false;
+    }
+
+    const u64_t* setOffsets = reinterpret_cast<const u64_t*>(base + sections.setOffsets);
+    const NodeID* setElems = reinterpret_cast<const NodeID*>(base + sections.setElems);
+    const NodeID* nodeToSet = reinterpret_cast<const NodeID*>(base + sections.nodeToSet);
+    const BinaryGepObj* gepObjs = reinterpret_cast<const BinaryGepObj*>(base + sections.gepObjs);
+    const NodeID* fiObjs = reinterpret_cast<const NodeID*>(base + sections.fiObjs);
+
+    // Points-to sets, each built on first use
+    PTDataTy* ptD = getPTDataTy();
+    std::vector<PointsTo> sets(header->numSets);
+    std::vector<bool> built(header->numSets, false);
+    for (NodeID var = 0; var < header->numNodes; ++var)
+    {
+        u32_t setId = nodeToSet[var];
+        if (setId == EmptySetID)
+            continue;
+        assert(setId < header->numSets && "invalid points-to set ID!");
+        if (!built[setId])
+        {
+            for (u64_t i = setOffsets[setId], e = setOffsets[setId + 1]; i < e; ++i)
+                sets[setId].set(setElems[i]);
+            built[setId] = true;
+        }
+        ptD->unionPts(var, sets[setId]);
+    }
+
+    // Gep objects created during solving
+    const SVFIR::NodeOffsetMap& gepObjVarMap = pag->getGepObjNodeMap();
+    for (u32_t i = 0; i < header->numGepObjs; ++i)
+    {
+        const BinaryGepObj& gepObj = gepObjs[i];
+        if (gepObjVarMap.find(std::make_pair(gepObj.base, gepObj.offset)) != gepObjVarMap.end())
+            continue;
+        SVFVar* node = pag->getGNode(gepObj.base);
+        const MemObj* obj = nullptr;
+        if (GepObjVar* gepObjVar = SVFUtil::dyn_cast<GepObjVar>(node))
+            obj = gepObjVar->getMemObj();
+        else if (FIObjVar* baseNode = SVFUtil::dyn_cast<FIObjVar>(node))
+            obj = baseNode->getMemObj();
+        else if (DummyObjVar* baseNode = SVFUtil::dyn_cast<DummyObjVar>(node))
+            obj = baseNode->getMemObj();
+        else
+            assert(false && "new gep obj node kind?");
+        pag->addGepObjNode(obj, gepObj.offset, gepObj.id);
+        NodeIDAllocator::get()->increaseNumOfObjAndNodes();
+    }
+
+    for (u32_t i = 0; i < header->numFIObjs; ++i)
+        setObjFieldInsensitive(fiObjs[i]);
+
+    munmap(addr, st.st_size);
+
+    // Update callgraph
+    updateCallGraph(pag->getIndirectCallsites());
+
+    outs() << "\n";
+    return true;
+}
 
 /*!
  * Dump points-to of each pag node
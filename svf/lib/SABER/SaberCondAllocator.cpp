@@ -44,7 +44,7 @@ u32_t ContextCond::maximumCxtLen = 0;
 u32_t ContextCond::maximumCxt = 0;
 u32_t ContextCond::maximumPathLen = 0;
 u32_t ContextCond::maximumPath = 0;
-u32_t SaberCondAllocator::totalCondNum = 0;
+thread_local u32_t SaberCondAllocator::totalCondNum = 0;
 
 
 SaberCondAllocator::SaberCondAllocator()
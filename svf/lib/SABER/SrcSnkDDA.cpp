@@ -33,10 +33,18 @@
 #include "Graphs/SVFGStat.h"
 #include "Util/Options.h"
 #include "WPA/Andersen.h"
+#include "Util/PhaseStat.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 using namespace SVF;
 using namespace SVFUtil;
 
+thread_local SrcSnkDDA::SliceWorker* SrcSnkDDA::threadWorker = nullptr;
+
 /// Initialize analysis
 void SrcSnkDDA::initialize(SVFModule* module)
 {
@@ -59,54 +67,122 @@ void SrcSnkDDA::initialize(SVFModule* module)
 
 void SrcSnkDDA::analyze(SVFModule* module)
 {
+    PhaseStat::Scope phase("SABER");
 
     initialize(module);
 
     ContextCond::setMaxCxtLen(Options::CxtLimit());
 
-    for (SVFGNodeSetIter iter = sourcesBegin(), eiter = sourcesEnd();
-            iter != eiter; ++iter)
+    if (Options::SaberThreads() > 1 && getSources().size() > 1)
+    {
+        analyzeInParallel();
+    }
+    else
     {
-        setCurSlice(*iter);
+        for (SVFGNodeSetIter iter = sourcesBegin(), eiter = sourcesEnd();
+                iter != eiter; ++iter)
+        {
+            analyzeSource(*iter);
 
-        DBOUT(DGENERAL, outs() << "Analysing slice:" << (*iter)->getId() << ")\n");
-        ContextCond cxt;
-        DPIm item((*iter)->getId(),cxt);
-        forwardTraverse(item);
+            if(Options::DumpSlice() && !getCurSlice()->isReachGlobal())
+                annotateSlice(getCurSlice());
 
-        /// do not consider there is bug when reaching a global SVFGNode
-        /// if we touch a global, then we assume the client uses this memory until the program exits.
-        if (getCurSlice()->isReachGlobal())
-        {
-            DBOUT(DSaber, outs() << "Forward analysis reaches globals for slice:" << (*iter)->getId() << ")\n");
+            reportBug(getCurSlice());
         }
-        else
-        {
-            DBOUT(DSaber, outs() << "Forward process for slice:" << (*iter)->getId() << " (size = " << getCurSlice()->getForwardSliceSize() << ")\n");
+    }
+    finalize();
 
-            for (SVFGNodeSetIter sit = getCurSlice()->sinksBegin(), esit =
-                        getCurSlice()->sinksEnd(); sit != esit; ++sit)
-            {
-                ContextCond cxt;
-                DPIm item((*sit)->getId(),cxt);
-                backwardTraverse(item);
-            }
+}
 
-            DBOUT(DSaber, outs() << "Backward process for slice:" << (*iter)->getId() << " (size = " << getCurSlice()->getBackwardSliceSize() << ")\n");
+void SrcSnkDDA::analyzeSource(const SVFGNode* src)
+{
+    setCurSlice(src);
 
-            if(Options::DumpSlice())
-                annotateSlice(_curSlice);
+    DBOUT(DGENERAL, outs() << "Analysing slice:" << src->getId() << ")\n");
+    ContextCond cxt;
+    DPIm item(src->getId(),cxt);
+    forwardTraverse(item);
 
-            if(_curSlice->AllPathReachableSolve())
-                _curSlice->setAllReachable();
+    /// do not consider there is bug when reaching a global SVFGNode
+    /// if we touch a global, then we assume the client uses this memory until the program exits.
+    if (getCurSlice()->isReachGlobal())
+    {
+        DBOUT(DSaber, outs() << "Forward analysis reaches globals for slice:" << src->getId() << ")\n");
+    }
+    else
+    {
+        DBOUT(DSaber, outs() << "Forward process for slice:" << src->getId() << " (size = " << getCurSlice()->getForwardSliceSize() << ")\n");
 
-            DBOUT(DSaber, outs() << "Guard computation for slice:" << (*iter)->getId() << ")\n");
+        for (SVFGNodeSetIter sit = getCurSlice()->sinksBegin(), esit =
+                    getCurSlice()->sinksEnd(); sit != esit; ++sit)
+        {
+            ContextCond cxt;
+            DPIm item((*sit)->getId(),cxt);
+            backwardTraverse(item);
         }
 
-        reportBug(getCurSlice());
+        DBOUT(DSaber, outs() << "Backward process for slice:" << src->getId() << " (size = " << getCurSlice()->getBackwardSliceSize() << ")\n");
+
+        if(getCurSlice()->AllPathReachableSolve())
+            getCurSlice()->setAllReachable();
+
+        DBOUT(DSaber, outs() << "Guard computation for slice:" << src->getId() << ")\n");
     }
-    finalize();
+}
+
+/*!
+ * Check sources on several threads. Slices of different sources are independent, so each thread
+ * owns a SliceWorker with its own worklist, visited maps and condition allocator, whose branch
+ * conditions live in the thread's own z3 context. Slices are computed as soon as a thread is free,
+ * but bugs are reported strictly in source order, which keeps the report identical to the
+ * sequential one and makes reportBug of the checkers safe to call without further locking.
+ */
+void SrcSnkDDA::analyzeInParallel()
+{
+    std::vector<const SVFGNode*> srcs(sourcesBegin(), sourcesEnd());
+    size_t numThreads = std::min<size_t>(Options::SaberThreads(), srcs.size());
+
+    std::atomic<size_t> next(0);
+    size_t nextToReport = 0;
+    std::mutex reportMutex;
+    std::condition_variable reportTurn;
+
+    auto work = [&]()
+    {
+        {
+            SliceWorker w;
+            threadWorker = &w;
+            w.saberCondAllocator->allocate(getPAG()->getModule());
+
+            for (size_t i = next++; i < srcs.size(); i = next++)
+            {
+                analyzeSource(srcs[i]);
+
+                std::unique_lock<std::mutex> lock(reportMutex);
+                reportTurn.wait(lock, [&nextToReport, i]()
+                {
+                    return nextToReport == i;
+                });
+
+                if(Options::DumpSlice() && !getCurSlice()->isReachGlobal())
+                    annotateSlice(getCurSlice());
+
+                reportBug(getCurSlice());
 
+                ++nextToReport;
+                reportTurn.notify_all();
+            }
+            threadWorker = nullptr;
+        }
+        /// conditions of this thread are gone with its worker, release its z3 context as well
+        Z3Expr::releaseContext();
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < numThreads; ++t)
+        workers.push_back(std::thread(work));
+    for (std::thread& w : workers)
+        w.join();
 }
 
 
@@ -270,14 +346,15 @@ void SrcSnkDDA::BWProcessIncomingEdge(const DPIm&, SVFGEdge* edge)
 /// Set current slice
 void SrcSnkDDA::setCurSlice(const SVFGNode* src)
 {
-    if(_curSlice!=nullptr)
+    SliceWorker& w = worker();
+    if(w.curSlice!=nullptr)
     {
-        delete _curSlice;
-        _curSlice = nullptr;
+        delete w.curSlice;
+        w.curSlice = nullptr;
         clearVisitedMap();
     }
 
-    _curSlice = new ProgSlice(src,getSaberCondAllocator(), getSVFG());
+    w.curSlice = new ProgSlice(src,getSaberCondAllocator(), getSVFG());
 }
 
 void SrcSnkDDA::annotateSlice(ProgSlice* slice)
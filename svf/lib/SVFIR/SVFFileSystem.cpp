@@ -2,6 +2,8 @@
 #include "Graphs/CHG.h"
 #include "SVFIR/SVFIR.h"
 #include "Util/CommandLine.h"
+#include <climits>
+#include <cstring>
 #include <sys/fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
@@ -882,6 +884,27 @@ std::pair<const cJSON*,const cJSON*> jsonUnpackPair(const cJSON* item)
     return {child1, child2};
 }
 
+u32_t jsonCountFields(const cJSON* first, const cJSON* rest)
+{
+    u32_t n = 0;
+    for (; first != rest; first = first->next)
+    {
+        ABORT_IFNOT(first, "Field not found");
+        ++n;
+    }
+    return n;
+}
+
+const cJSON* jsonSkipFields(const cJSON* first, u32_t n)
+{
+    for (; n > 0; --n)
+    {
+        ABORT_IFNOT(first, "Missing field");
+        first = first->next;
+    }
+    return first;
+}
+
 double jsonGetNumber(const cJSON* item)
 {
     ABORT_IFNOT(jsonIsNumber(item), "Expected number for " << JSON_KEY(item));
@@ -954,6 +977,124 @@ bool jsonAddItemToArray(cJSON* array, cJSON* item)
     return cJSON_AddItemToArray(array, item);
 }
 
+LazyJson::LazyJson(const cJSON* item) : item(item), parsed(nullptr)
+{
+    if (!isLazy(item))
+        return;
+    parsed = cJSON_ParseWithLength(item->valuestring, item->valueint);
+    ABORT_IFNOT(parsed, "Invalid JSON for " << JSON_KEY(item));
+    // The key is owned by item
+    parsed->string = item->string;
+    parsed->type |= cJSON_StringIsConst;
+}
+
+cJSON* LazyJson::create(const char* text, size_t length)
+{
+    ABORT_IFNOT(length <= static_cast<size_t>(INT_MAX), "JSON value too long");
+    cJSON* item = cJSON_CreateNull();
+    // A reference, so that cJSON_Delete() does not free text
+    item->type = cJSON_Raw | cJSON_IsReference;
+    item->valuestring = const_cast<char*>(text);
+    item->valueint = static_cast<int>(length);
+    return item;
+}
+
+bool LazyJson::isLazy(const cJSON* item)
+{
+    return item && (item->type & 0xFF) == cJSON_Raw &&
+           (item->type & cJSON_IsReference);
+}
+
+JsonStreamWriter::JsonStreamWriter(std::ostream& os, bool humanReadable)
+    : os(os), humanReadable(humanReadable)
+{
+}
+
+void JsonStreamWriter::writeTabs(size_t depth)
+{
+    for (size_t i = 0; i < depth; ++i)
+        os << '\t';
+}
+
+void JsonStreamWriter::beginMember(const char* name)
+{
+    if (scopes.empty())
+        return;
+
+    std::pair<bool, bool>& scope = scopes.back();
+    if (scope.first)
+    {
+        if (scope.second)
+            os << ',' << '\n';
+        writeTabs(scopes.size());
+        os << '"' << name << '"' << ':' << '\t';
+    }
+    else if (scope.second)
+    {
+        os << (humanReadable ? ", " : ",");
+    }
+    scope.second = true;
+}
+
+void JsonStreamWriter::endScope(char close)
+{
+    assert(!scopes.empty() && "No object or array to close");
+    bool isObject = scopes.back().first;
+    bool hasMember = scopes.back().second;
+    scopes.pop_back();
+    if (isObject)
+    {
+        if (hasMember)
+            os << '\n';
+        writeTabs(scopes.size());
+    }
+    os << close;
+}
+
+void JsonStreamWriter::beginObject(const char* name)
+{
+    // Objects are arrays when the JSON is not human-readable.
+    if (!humanReadable)
+        return beginArray(name);
+    beginMember(name);
+    os << '{' << '\n';
+    scopes.emplace_back(true, false);
+}
+
+void JsonStreamWriter::endObject()
+{
+    endScope(humanReadable ? '}' : ']');
+}
+
+void JsonStreamWriter::beginArray(const char* name)
+{
+    beginMember(name);
+    os << '[';
+    scopes.emplace_back(false, false);
+}
+
+void JsonStreamWriter::endArray()
+{
+    endScope(']');
+}
+
+void JsonStreamWriter::writeItem(const char* name, cJSON* item)
+{
+    beginMember(name);
+    char* str = humanReadable ? cJSON_Print(item) : cJSON_PrintUnformatted(item);
+    // Nested objects are indented relative to the enclosing ones.
+    const char* line = str;
+    while (const char* newline = std::strchr(line, '\n'))
+    {
+        os.write(line, newline - line + 1);
+        writeTabs(scopes.size());
+        line = newline + 1;
+    }
+    os << line;
+    cJSON_free(str);
+    cJSON_Delete(item);
+}
+
 ICFGWriter::ICFGWriter(const ICFG* icfg) : GenericICFGWriter(icfg)
 {
     for (const auto& pair : icfg->getIcfgNodeToSVFLoopVec())
@@ -999,7 +1140,9 @@ SVFIRWriter::SVFIRWriter(const SVFIR* svfir)
 void SVFIRWriter::writeJsonToOstream(const SVFIR* svfir, std::ostream& os)
 {
     SVFIRWriter writer(svfir);
-    os << writer.generateJsonString().get() << '\n';
+    JsonStreamWriter jsonWriter(os, humanReadableOption());
+    writer.writeJson(jsonWriter);
+    os << '\n';
 }
 
 void SVFIRWriter::writeJsonToPath(const SVFIR* svfir, const std::string& path)
@@ -1027,27 +1170,19 @@ const char* SVFIRWriter::numToStr(size_t n)
     return numToStrMap.emplace_hint(it, n, std::to_string(n))->second.c_str();
 }
 
-SVFIRWriter::autoCStr SVFIRWriter::generateJsonString()
-{
-    autoJSON object = generateJson();
-    char* str = humanReadableOption() ? cJSON_Print(object.get())
-                : cJSON_PrintUnformatted(object.get());
-    return {str, cJSON_free};
-}
-
-SVFIRWriter::autoJSON SVFIRWriter::generateJson()
+void SVFIRWriter::writeJson(JsonStreamWriter& writer)
 {
     const IRGraph* const irGraph = svfIR;
     NodeIDAllocator* nodeIDAllocator = NodeIDAllocator::allocator;
     assert(nodeIDAllocator && "NodeIDAllocator is not initialized?");
 
-    cJSON* root = jsonCreateObject();
-#define F(field) JSON_WRITE_FIELD(root, svfIR, field)
-    F(svfModule);
-    F(symInfo);
-    F(icfg);
-    F(chgraph);
-    jsonAddJsonableToObject(root, FIELD_NAME_ITEM(irGraph));
+    writer.beginObject();
+#define F(field) writeJsonable(writer, #field, svfIR->field)
+    writeJson(writer, "svfModule", svfIR->svfModule);
+    writeJson(writer, "symInfo", svfIR->symInfo);
+    writeJson(writer, "icfg", svfIR->icfg);
+    writeJson(writer, "chgraph", svfIR->chgraph);
+    writeJson(writer, "irGraph", irGraph);
     F(icfgNode2SVFStmtsMap);
     F(icfgNode2PTASVFStmtsMap);
     F(GepValObjMap);
@@ -1064,10 +1199,9 @@ SVFIRWriter::autoJSON SVFIRWriter::generateJson()
     F(funPtrToCallSitesMap);
     F(candidatePointers);
     F(callSiteSet);
-    jsonAddJsonableToObject(root, FIELD_NAME_ITEM(nodeIDAllocator));
+    writeJsonable(writer, FIELD_NAME_ITEM(nodeIDAllocator));
 #undef F
-
-    return {root, cJSON_Delete};
+    writer.endObject();
 }
 
 cJSON* SVFIRWriter::toJson(const SVFType* type)
@@ -1080,12 +1214,14 @@ cJSON* SVFIRWriter::toJson(const SVFValue* value)
     return jsonCreateIndex(svfModuleWriter.getSVFValueID(value));
 }
 
-cJSON* SVFIRWriter::toJson(const IRGraph* graph)
+void SVFIRWriter::writeJson(JsonStreamWriter& writer, const char* name,
+                            const IRGraph* graph)
 {
     ENSURE_NOT_VISITED(graph);
 
-    cJSON* root = genericGraphToJson(graph, irGraphWriter.edgePool.getPool());
-#define F(field) JSON_WRITE_FIELD(root, graph, field)
+    writer.beginObject(name);
+    writeGenericGraph(writer, graph, irGraphWriter.edgePool.getPool());
+#define F(field) writeJsonable(writer, #field, graph->field)
     F(KindToSVFStmtSetMap);
     F(KindToPTASVFStmtSetMap);
     F(fromFile);
@@ -1093,7 +1229,7 @@ cJSON* SVFIRWriter::toJson(const IRGraph* graph)
     F(totalPTAPAGEdge);
     F(valueToEdgeMap);
 #undef F
-    return root;
+    writer.endObject();
 }
 
 cJSON* SVFIRWriter::toJson(const SVFVar* var)
@@ -1106,18 +1242,21 @@ cJSON* SVFIRWriter::toJson(const SVFStmt* stmt)
     return jsonCreateIndex(irGraphWriter.getEdgeID(stmt));
 }
 
-cJSON* SVFIRWriter::toJson(const ICFG* icfg)
+void SVFIRWriter::writeJson(JsonStreamWriter& writer, const char* name,
+                            const ICFG* icfg)
 {
-    cJSON* allSvfLoop = jsonCreateArray(); // all indices seen in constructor
+    writer.beginObject(name);
+    writeGenericGraph(writer, icfg, icfgWriter.edgePool.getPool());
+
+    writer.beginArray("allSvfLoop"); // Meta field
+    // all indices seen in constructor
     for (const SVFLoop* svfLoop : icfgWriter.svfLoopPool)
     {
-        cJSON* svfLoopObj = contentToJson(svfLoop);
-        jsonAddItemToArray(allSvfLoop, svfLoopObj);
+        writer.writeItem(nullptr, contentToJson(svfLoop));
     }
+    writer.endArray();
 
-#define F(field) JSON_WRITE_FIELD(root, icfg, field)
-    cJSON* root = genericGraphToJson(icfg, icfgWriter.edgePool.getPool());
-    jsonAddItemToObject(root, FIELD_NAME_ITEM(allSvfLoop)); // Meta field
+#define F(field) writeJsonable(writer, #field, icfg->field)
     F(totalICFGNode);
     F(FunToFunEntryNodeMap);
     F(FunToFunExitNodeMap);
@@ -1127,7 +1266,7 @@ cJSON* SVFIRWriter::toJson(const ICFG* icfg)
     F(globalBlockNode);
     F(icfgNodeToSVFLoopVec);
 #undef F
-    return root;
+    writer.endObject();
 }
 
 cJSON* SVFIRWriter::toJson(const ICFGNode* node)
@@ -1142,17 +1281,20 @@ cJSON* SVFIRWriter::toJson(const ICFGEdge* edge)
     return jsonCreateIndex(icfgWriter.getEdgeID(edge));
 }
 
-cJSON* SVFIRWriter::toJson(const CommonCHGraph* graph)
+void SVFIRWriter::writeJson(JsonStreamWriter& writer, const char* name,
+                            const CommonCHGraph* graph)
 {
     auto chg = SVFUtil::dyn_cast<CHGraph>(graph);
     assert(chg && "Unsupported CHGraph type!");
-    return toJson(chg);
+    writeJson(writer, name, chg);
 }
 
-cJSON* SVFIRWriter::toJson(const CHGraph* graph)
+void SVFIRWriter::writeJson(JsonStreamWriter& writer, const char* name,
+                            const CHGraph* graph)
 {
-    cJSON* root = genericGraphToJson(graph, chgWriter.edgePool.getPool());
-#define F(field) JSON_WRITE_FIELD(root, graph, field)
+    writer.beginObject(name);
+    writeGenericGraph(writer, graph, chgWriter.edgePool.getPool());
+#define F(field) writeJsonable(writer, #field, graph->field)
     // TODO: Ensure svfMod is the same as the SVFIR's?
     F(classNum);
     F(vfID);
@@ -1167,7 +1309,7 @@ cJSON* SVFIRWriter::toJson(const CHGraph* graph)
     F(csToCHAVtblsMap);
     F(csToCHAVFnsMap);
 #undef F
-    return root;
+    writer.endObject();
 }
 
 cJSON* SVFIRWriter::toJson(const CHNode* node)
@@ -1273,22 +1415,21 @@ cJSON* SVFIRWriter::toJson(const NodeIDAllocator* nodeIDAllocator)
     return root;
 }
 
-cJSON* SVFIRWriter::toJson(const SymbolTableInfo* symTable)
+void SVFIRWriter::writeJson(JsonStreamWriter& writer, const char* name,
+                            const SymbolTableInfo* symTable)
 {
     ENSURE_NOT_VISITED(symTable);
 
-    cJSON* root = jsonCreateObject();
-    cJSON* allMemObj = jsonCreateArray();
+    writer.beginObject(name);
+    writer.beginArray("allMemObj"); // Actual field
     for (const auto& pair : symTable->objMap)
     {
         const MemObj* memObj = pair.second;
-        cJSON* memObjJson = contentToJson(memObj);
-        jsonAddItemToArray(allMemObj, memObjJson);
+        writer.writeItem(nullptr, contentToJson(memObj));
     }
+    writer.endArray();
 
-#define F(field) JSON_WRITE_FIELD(root, symTable, field)
-    jsonAddItemToObject(root, FIELD_NAME_ITEM(allMemObj)); // Actual field
-
+#define F(field) writeJsonable(writer, #field, symTable->field)
     F(valSymMap);
     F(objSymMap);
     F(returnSymMap);
@@ -1303,33 +1444,31 @@ cJSON* SVFIRWriter::toJson(const SymbolTableInfo* symTable)
     // Field svfTypes can be represented by svfModuleWriter.svfTypePool
     // Field stInfos can be represented by svfModuleWriter.stInfoPool
 #undef F
-
-    return root;
+    writer.endObject();
 }
 
-cJSON* SVFIRWriter::toJson(const SVFModule* module)
+void SVFIRWriter::writeJson(JsonStreamWriter& writer, const char* name,
+                            const SVFModule* module)
 {
-    cJSON* root = jsonCreateObject();
-    cJSON* allSVFType = jsonCreateArray();
-    cJSON* allStInfo = jsonCreateArray();
-    cJSON* allSVFValue = jsonCreateArray();
-
+    writer.beginObject(name);
+    writer.beginArray("allSVFType"); // Meta field
     for (const SVFType* svfType : svfModuleWriter.svfTypePool)
     {
-        cJSON* svfTypeObj = virtToJson(svfType);
-        jsonAddItemToArray(allSVFType, svfTypeObj);
+        writer.writeItem(nullptr, virtToJson(svfType));
     }
+    writer.endArray();
 
+    writer.beginArray("allStInfo"); // Meta field
     for (const StInfo* stInfo : svfModuleWriter.stInfoPool)
     {
-        cJSON* stInfoObj = contentToJson(stInfo);
-        jsonAddItemToArray(allStInfo, stInfoObj);
+        writer.writeItem(nullptr, contentToJson(stInfo));
     }
+    writer.endArray();
 
-#define F(field) JSON_WRITE_FIELD(root, module, field)
-    jsonAddItemToObject(root, FIELD_NAME_ITEM(allSVFType));  // Meta field
-    jsonAddItemToObject(root, FIELD_NAME_ITEM(allStInfo));   // Meta field
-    jsonAddItemToObject(root, FIELD_NAME_ITEM(allSVFValue)); // Meta field
+    // The remaining fields come after allSVFValue, but the values they refer
+    // to have to be numbered first, as allSVFValue contains all of them.
+    cJSON* fields = jsonCreateObject();
+#define F(field) JSON_WRITE_FIELD(fields, module, field)
     F(pagReadFromTxt);
     F(moduleIdentifier);
 
@@ -1340,13 +1479,22 @@ cJSON* SVFIRWriter::toJson(const SVFModule* module)
     F(OtherValueSet);
 #undef F
 
+    // The pool grows as values refer to values not seen yet.
+    writer.beginArray("allSVFValue"); // Meta field
     for (size_t i = 1; i <= svfModuleWriter.sizeSVFValuePool(); ++i)
     {
-        cJSON* value = virtToJson(svfModuleWriter.getSVFValuePtr(i));
-        jsonAddItemToArray(allSVFValue, value);
+        writer.writeItem(nullptr,
+                         virtToJson(svfModuleWriter.getSVFValuePtr(i)));
     }
+    writer.endArray();
 
-    return root;
+    while (cJSON* field = fields->child)
+    {
+        cJSON_DetachItemViaPointer(fields, field);
+        writer.writeItem(field->string, field);
+    }
+    cJSON_Delete(fields);
+    writer.endObject();
 }
 
 SVFIR* SVFIRReader::read(const cJSON* root)
@@ -2537,6 +2685,124 @@ void SVFIRReader::fill(const cJSON*& fieldJson, SVFOtherType* type)
     JSON_READ_FIELD_FWD(fieldJson, type, repr);
 }
 
+/// Containers nested deeper than this are left unparsed (see LazyJson). The
+/// root, its parts (e.g., the ICFG) and their fields (e.g., allNode) are
+/// parsed, but not the elements of the fields (e.g., a node).
+static constexpr u32_t maxParsedJsonDepth = 2;
+
+static const char* jsonSkipSpace(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+        ++p;
+    return p;
+}
+
+/// Returns the end of the JSON value starting at p.
+static const char* jsonSkipValue(const char* p, const char* end)
+{
+    if (*p == '"')
+    {
+        for (++p; p < end && *p != '"'; ++p)
+        {
+            if (*p == '\\')
+                ++p;
+        }
+        ABORT_IFNOT(p < end, "Unterminated JSON string");
+        return p + 1;
+    }
+    if (*p == '{' || *p == '[')
+    {
+        u32_t depth = 0;
+        do
+        {
+            if (*p == '"')
+            {
+                p = jsonSkipValue(p, end);
+                continue;
+            }
+            if (*p == '{' || *p == '[')
+                ++depth;
+            else if (*p == '}' || *p == ']')
+                --depth;
+            ++p;
+        }
+        while (depth > 0 && p < end);
+        ABORT_IFNOT(depth == 0, "Unterminated JSON object or array");
+        return p;
+    }
+    while (p < end && !std::strchr(",]} \t\r\n", *p))
+        ++p;
+    return p;
+}
+
+/// Parse the JSON value at p (advanced to its end) with the containers deeper
+/// than maxParsedJsonDepth left as lazy values referring to the text.
+static cJSON* jsonParseOutline(const char*& p, const char* end, u32_t depth)
+{
+    p = jsonSkipSpace(p, end);
+    ABORT_IFNOT(p < end, "Unexpected end of JSON");
+    const char* begin = p;
+
+    if (*p != '{' && *p != '[')
+    {
+        p = jsonSkipValue(p, end);
+        cJSON* scalar = cJSON_ParseWithLength(begin, p - begin);
+        ABORT_IFNOT(scalar, "Invalid JSON value");
+        return scalar;
+    }
+    if (depth > maxParsedJsonDepth)
+    {
+        p = jsonSkipValue(p, end);
+        return LazyJson::create(begin, p - begin);
+    }
+
+    const bool isObject = *p == '{';
+    const char close = isObject ? '}' : ']';
+    cJSON* container = isObject ? cJSON_CreateObject() : cJSON_CreateArray();
+    p = jsonSkipSpace(p + 1, end);
+    if (p < end && *p == close)
+    {
+        ++p;
+        return container;
+    }
+
+    while (true)
+    {
+        cJSON* key = nullptr;
+        if (isObject)
+        {
+            p = jsonSkipSpace(p, end);
+            const char* keyBegin = p;
+            ABORT_IFNOT(p < end && *p == '"', "Expect key in JSON object");
+            p = jsonSkipValue(p, end);
+            key = cJSON_ParseWithLength(keyBegin, p - keyBegin);
+            p = jsonSkipSpace(p, end);
+            ABORT_IFNOT(p < end && *p == ':', "Expect ':' in JSON object");
+            ++p;
+        }
+
+        cJSON* child = jsonParseOutline(p, end, depth + 1);
+        if (key)
+        {
+            cJSON_AddItemToObject(container, key->valuestring, child);
+            cJSON_Delete(key);
+        }
+        else
+            cJSON_AddItemToArray(container, child);
+
+        p = jsonSkipSpace(p, end);
+        ABORT_IFNOT(p < end, "Unexpected end of JSON");
+        if (*p == ',')
+        {
+            ++p;
+            continue;
+        }
+        ABORT_IFNOT(*p == close, "Expect '" << close << "' in JSON");
+        ++p;
+        return container;
+    }
+}
+
 SVFIR* SVFIRReader::read(const std::string& path)
 {
     struct stat buf;
@@ -2562,7 +2828,15 @@ SVFIR* SVFIRReader::read(const std::string& path)
         abort();
     }
 
-    auto root = cJSON_ParseWithLength(addr, buf.st_size);
+    // Only the outline of the file is parsed up front. The rest is parsed
+    // element by element while reading, so the file stays mapped until then.
+    const char* text = addr;
+    cJSON* root = jsonParseOutline(text, addr + buf.st_size, 0);
+
+    SVFIRReader reader;
+    SVFIR* ir = reader.read(root);
+
+    cJSON_Delete(root);
 
     if (munmap(addr, buf.st_size) == -1)
         perror("munmap()");
@@ -2570,10 +2844,6 @@ SVFIR* SVFIRReader::read(const std::string& path)
     if (close(fd) < 0)
         perror("close()");
 
-    SVFIRReader reader;
-    SVFIR* ir = reader.read(root);
-
-    cJSON_Delete(root);
     return ir;
 }
 
@@ -0,0 +1,114 @@
+//===- CallStrCxt.cpp -- Interned call string contexts ------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * CallStrCxt.cpp
+ */
+
+#include "Util/CallStrCxt.h"
+#include <sstream>
+
+using namespace SVF;
+
+CallStrCxt::Trie::Trie()
+{
+    // The root is the empty context, its own parent.
+    nodes.push_back({0, 0, 0});
+}
+
+CallStrCxt::Trie& CallStrCxt::getTrie()
+{
+    static Trie trie;
+    return trie;
+}
+
+void CallStrCxt::push_back(CallSiteID csId)
+{
+    Trie& trie = getTrie();
+    u64_t key = ((u64_t) id << 32) | csId;
+    auto it = trie.children.emplace(key, trie.nodes.size());
+    if (it.second)
+    {
+        assert(trie.nodes.size() < UINT32_MAX && "too many contexts");
+        trie.nodes.push_back({id, csId, trie.nodes[id].depth + 1});
+    }
+    id = it.first->second;
+}
+
+void CallStrCxt::pop_front()
+{
+    assert(!empty() && "pop from an empty context");
+    std::vector<CallSiteID> callSites = toVector();
+    id = 0;
+    for (u32_t i = 1; i < callSites.size(); ++i)
+        push_back(callSites[i]);
+}
+
+CallSiteID CallStrCxt::operator[](u32_t index) const
+{
+    u32_t depth = size();
+    assert(index < depth && "index out of range");
+    CxtID cur = id;
+    for (u32_t i = index + 1; i < depth; ++i)
+        cur = getNode(cur).parent;
+    return getNode(cur).csId;
+}
+
+bool CallStrCxt::contains(CallSiteID csId) const
+{
+    for (CxtID cur = id; cur != 0; cur = getNode(cur).parent)
+    {
+        if (getNode(cur).csId == csId)
+            return true;
+    }
+    return false;
+}
+
+std::vector<CallSiteID> CallStrCxt::toVector() const
+{
+    std::vector<CallSiteID> callSites(size());
+    CxtID cur = id;
+    for (auto it = callSites.rbegin(), eit = callSites.rend(); it != eit; ++it)
+    {
+        *it = getNode(cur).csId;
+        cur = getNode(cur).parent;
+    }
+    return callSites;
+}
+
+std::string CallStrCxt::toString() const
+{
+    std::string str;
+    std::stringstream rawstr(str);
+    rawstr << "[:";
+    for (CallSiteID csId : toVector())
+    {
+        rawstr << csId << " ";
+    }
+    rawstr << " ]";
+    return rawstr.str();
+}
+
+u32_t CallStrCxt::getNumOfCxts()
+{
+    return getTrie().nodes.size();
+}
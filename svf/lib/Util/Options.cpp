@@ -50,6 +50,18 @@ const OptionMap<BVDataPTAImpl::PTBackingType> Options::ptDataBacking(
 }
 );
 
+const Option<u32_t> Options::PtsGCThreshold(
+    "ptd-gc-threshold",
+    "collect dead points-to sets of the persistent cache once it holds this many sets (0 disables)",
+    0
+);
+
+const Option<u32_t> Options::PtsOpCacheLimit(
+    "ptd-op-cache-limit",
+    "maximum number of entries in each persistent points-to operation cache (0 means unbounded)",
+    0
+);
+
 const Option<u32_t> Options::FsTimeLimit(
     "fs-time-limit",
     "time limit for main phase of flow-sensitive analyses",
@@ -62,6 +74,24 @@ const Option<u32_t> Options::VersioningThreads(
     1
 );
 
+const Option<u32_t> Options::VFSThreads(
+    "vfs-threads",
+    "number of threads to use in the version propagation of versioned flow-sensitive analysis (1 means sequential)",
+    1
+);
+
+const Option<u32_t> Options::AnderThreads(
+    "ander-threads",
+    "number of threads to use in the wave propagation of Andersen's analysis (1 means sequential)",
+    1
+);
+
+const Option<u32_t> Options::SCCThreads(
+    "scc-threads",
+    "number of threads to use in SCC detection on the SVFG by flow-sensitive analyses (1 means sequential)",
+    1
+);
+
 const Option<u32_t> Options::AnderTimeLimit(
     "ander-time-limit",
     "time limit for Andersen's analyses (ignored when -fs-time-limit set)",
@@ -196,6 +226,18 @@ OptionMultiple<PointerAnalysis::PTATY> Options::DDASelected(
 }
 );
 
+const Option<std::string> Options::DDAServer(
+    "dda-server",
+    "Answer points-to/alias queries line by line after building the SVFG once: -dda-server=stdin or -dda-server=<unix socket path>",
+    ""
+);
+
+const Option<u32_t> Options::DDACacheBudget(
+    "dda-cache-mb",
+    "Memory budget (MB) of the points-to cache kept across DDA queries, least recently used entries are evicted first (0: unbounded)",
+    0
+);
+
 // FlowDDA.cpp
 const Option<u32_t> Options::FlowBudget(
     "flow-bg",
@@ -329,6 +371,12 @@ const Option<bool> Options::ReadJson(
     false
 );
 
+const Option<std::string> Options::SVFIRCacheDir(
+    "svfir-cache",
+    "Directory caching the SVFIRs built from bitcode files, reused while the files and SVFIR options are unchanged",
+    ""
+);
+
 const Option<bool> Options::CallGraphDotGraph(
     "dump-callgraph",
     "Dump dot graph of Call Graph",
@@ -471,6 +519,12 @@ const OptionMap<MemSSA::MemPartition> Options::MemPar(
 }
 );
 
+const Option<u32_t> Options::MSSAThreads(
+    "mssa-threads",
+    "number of threads building memory SSA (mod-ref of call graph SCCs and functions) in parallel (1 means sequential)",
+    1
+);
+
 
 // SVFG builder (SVFGBuilder.cpp)
 const Option<bool> Options::SVFGWithIndirectCall(
@@ -497,6 +551,12 @@ const Option<std::string> Options::ReadSVFG(
     ""
 );
 
+const Option<bool> Options::SVFGTextFormat(
+    "svfg-text",
+    "Write the SVFG (-write-svfg) in the legacy text format instead of the binary one",
+    false
+);
+
 // FSMPTA.cpp
 const Option<bool> Options::UsePCG(
     "pcg-td-edge",
@@ -522,6 +582,12 @@ const Option<u32_t> Options::AddModelFlag(
     0
 );
 
+const Option<u32_t> Options::TDEdgeThreads(
+    "td-edge-threads",
+    "number of threads checking MHP of candidate store/load pairs when adding thread SVFG edges (1 means sequential)",
+    1
+);
+
 
 // LockAnalysis.cpp
 const Option<bool> Options::PrintLockSpan(
@@ -626,6 +692,12 @@ const Option<u32_t> Options::CxtLimit(
     3
 );
 
+const Option<u32_t> Options::SaberThreads(
+    "saber-threads",
+    "number of threads checking sources in parallel in source-sink analysis (1 means sequential)",
+    1
+);
+
 
 // CHG.cpp
 const Option<bool> Options::DumpCHA(
@@ -656,6 +728,12 @@ const Option<bool> Options::SVFMain(
     false
 );
 
+const Option<u32_t> Options::LoadThreads(
+    "load-threads",
+    "number of threads to use in parsing and pre-processing LLVM modules (1 means sequential)",
+    1
+);
+
 const Option<bool> Options::ModelConsts(
     "model-consts",
     "Modeling individual constant objects",
@@ -751,6 +829,18 @@ const Option<std::string> Options::ReadAnder(
     ""
 );
 
+const Option<bool> Options::BinaryAnder(
+    "binary-ander",
+    "Write Andersen's analysis results (-write-ander) in the binary, memory-mappable format; -read-ander detects it automatically",
+    false
+);
+
+const Option<std::string> Options::IncrementalAnder(
+    "incremental-ander",
+    "-incremental-ander=<file>: re-solve only the constraints affected by program changes since the run that wrote <file>, then update <file>",
+    ""
+);
+
 const Option<bool> Options::DiffPts(
     "diff",
     "Enable differential point-to set",
@@ -873,6 +963,18 @@ const Option<bool> Options::POCRHybrid(
     false
 );
 
+const Option<bool> Options::CFLBitMatrix(
+    "cfl-bit-matrix",
+    "When explicit to true, CFL alias and value-flow analyses use BitMatrixCFLSolver, which applies productions to per-symbol bit-matrices round by round.",
+    false
+);
+
+const Option<bool> Options::CFLEdgeTriples(
+    "cfl-edge-triples",
+    "When explicit to true, CFL alias and value-flow analyses use CompactCFLSolver, which keeps derived edges as packed triples and adds only start symbol edges to the CFL graph.",
+    false
+);
+
 const Option<bool> Options::Customized(
     "customized",
     "When explicit to true, user can use any grammar file.",
@@ -0,0 +1,136 @@
+//===- PhaseStat.cpp -- Timing and memory of analysis phases -----------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PhaseStat.cpp
+ */
+
+#include "Util/PhaseStat.h"
+
+#include <cstdio>
+#include <cstring>
+#include <sys/resource.h>
+#include <time.h>
+
+using namespace SVF;
+
+bool PhaseStat::enabled = false;
+PhaseStat::PhaseList PhaseStat::phases;
+std::vector<PhaseStat::OpenPhase> PhaseStat::openPhases;
+
+double PhaseStat::getWallTime()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+double PhaseStat::getCPUTime()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6
+           + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+/*!
+ * VmHWM of /proc/self/status, falling back to the peak of the whole process
+ * where it is not available.
+ */
+u64_t PhaseStat::getPeakRSS()
+{
+    if (FILE* status = fopen("/proc/self/status", "r"))
+    {
+        char line[256];
+        u64_t peak = 0;
+        bool found = false;
+        while (!found && fgets(line, sizeof(line), status))
+            found = sscanf(line, "VmHWM: %llu kB", (unsigned long long*) &peak) == 1;
+        fclose(status);
+        if (found)
+            return peak;
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/*!
+ * Writing 5 to clear_refs resets VmHWM to the current RSS (Linux 4.0 onwards), so that
+ * the peak of each phase can be told apart. Where it fails, peaks are those of the process so far.
+ */
+void PhaseStat::resetPeakRSS()
+{
+    if (FILE* clearRefs = fopen("/proc/self/clear_refs", "w"))
+    {
+        fputs("5", clearRefs);
+        fclose(clearRefs);
+    }
+}
+
+void PhaseStat::startPhase(const std::string& name)
+{
+    // The peak reached so far by the enclosing phase would be lost by the reset.
+    if (!openPhases.empty())
+        openPhases.back().peakRSS = std::max(openPhases.back().peakRSS, getPeakRSS());
+    resetPeakRSS();
+
+    Phase phase;
+    phase.name = name;
+    phase.depth = openPhases.size();
+    phase.wallTime = 0;
+    phase.cpuTime = 0;
+    phase.peakRSS = 0;
+    phases.push_back(phase);
+
+    OpenPhase open;
+    open.index = phases.size() - 1;
+    open.peakRSS = 0;
+    open.cpuStart = getCPUTime();
+    open.wallStart = getWallTime();
+    openPhases.push_back(open);
+}
+
+void PhaseStat::endPhase()
+{
+    assert(!openPhases.empty() && "PhaseStat::endPhase: no phase started!");
+    double wallEnd = getWallTime();
+    double cpuEnd = getCPUTime();
+
+    OpenPhase open = openPhases.back();
+    openPhases.pop_back();
+
+    Phase& phase = phases[open.index];
+    phase.wallTime = wallEnd - open.wallStart;
+    phase.cpuTime = cpuEnd - open.cpuStart;
+    phase.peakRSS = std::max(open.peakRSS, getPeakRSS());
+
+    if (!openPhases.empty())
+        openPhases.back().peakRSS = std::max(openPhases.back().peakRSS, phase.peakRSS);
+}
+
+void PhaseStat::clear()
+{
+    phases.clear();
+    openPhases.clear();
+}
@@ -32,8 +32,8 @@
 namespace SVF
 {
 
-z3::context *Z3Expr::ctx = nullptr;
-z3::solver* Z3Expr::solver = nullptr;
+thread_local z3::context *Z3Expr::ctx = nullptr;
+thread_local z3::solver* Z3Expr::solver = nullptr;
 
 
 /// release z3 context
@@ -52,7 +52,7 @@ void Z3Expr::releaseSolver()
     solver = nullptr;
 }
 
-/// Get z3 solver, singleton design here to make sure we only have one context
+/// Get z3 solver, singleton design here to make sure we only have one context per thread
 z3::solver &Z3Expr::getSolver()
 {
     if (solver == nullptr)
@@ -62,7 +62,7 @@ z3::solver &Z3Expr::getSolver()
     return *solver;
 }
 
-/// Get z3 context, singleton design here to make sure we only have one context
+/// Get z3 context, singleton design here to make sure we only have one context per thread
 z3::context &Z3Expr::getContext()
 {
     if (ctx == nullptr)
@@ -30,6 +30,7 @@
 #include "Util/Options.h"
 #include "Graphs/CHG.h"
 #include "Util/SVFUtil.h"
+#include "Util/PhaseStat.h"
 #include "MemoryModel/PointsTo.h"
 #include "WPA/Andersen.h"
 #include "WPA/Steensgaard.h"
@@ -115,6 +116,8 @@ void AndersenBase::solveConstraints()
 
         solveWorklist();
 
+        collectPtsGarbageIfNeeded();
+
         if (updateCallGraph(getIndirectCallsites()))
             reanalyze = true;
 
@@ -132,10 +135,15 @@ void AndersenBase::solveConstraints()
  */
 void AndersenBase::analyze()
 {
+    PhaseStat::Scope phase(PTAName());
     if(!Options::ReadAnder().empty())
     {
         readPtsFromFile(Options::ReadAnder());
     }
+    else if(!Options::IncrementalAnder().empty())
+    {
+        solveIncrementally(Options::IncrementalAnder());
+    }
     else
     {
         if(Options::WriteAnder().empty())
@@ -162,6 +170,17 @@ void AndersenBase::readPtsFromFile(const std::string& filename)
     finalize();
 }
 
+/*!
+ * Andersen analysis: incremental solving is only supported by Andersen and its
+ * variants, other solvers fall back to solving from scratch
+ */
+void AndersenBase::solveIncrementally(const std::string&)
+{
+    initialize();
+    solveConstraints();
+    finalize();
+}
+
 /*!
  * Andersen analysis: solve constraints and write pointer analysis result to file
  */
@@ -169,20 +188,22 @@ void AndersenBase:: solveAndwritePtsToFile(const std::string& filename)
 {
     /// Initialization for the Solver
     initialize();
-    if (!filename.empty())
+    /// The binary format records field-insensitive objects after solving only
+    if (!filename.empty() && !Options::BinaryAnder())
         this->writeObjVarToFile(filename);
     solveConstraints();
     if (!filename.empty())
-        this->writeToFile(filename);
+    {
+        if (Options::BinaryAnder())
+            this->writeToBinaryFile(filename);
+        else
+            this->writeToFile(filename);
+    }
     finalize();
 }
 
 void AndersenBase::cleanConsCG(NodeID id)
 {
-    consCG->resetSubs(consCG->getRep(id));
-    for (NodeID sub: consCG->getSubs(id))
-        consCG->resetRep(sub);
-    consCG->resetSubs(id);
     consCG->resetRep(id);
     assert(!consCG->hasGNode(id) && "this is either a rep nodeid or a sub nodeid should have already been merged to its field-insensitive base! ");
 }
@@ -847,19 +868,6 @@ void Andersen::mergeNodeToRep(NodeID nodeId,NodeID newRepId)
 void Andersen::updateNodeRepAndSubs(NodeID nodeId, NodeID newRepId)
 {
     consCG->setRep(nodeId,newRepId);
-    NodeBS repSubs;
-    repSubs.set(nodeId);
-    /// update nodeToRepMap, for each subs of current node updates its rep to newRepId
-    //  update nodeToSubsMap, union its subs with its rep Subs
-    NodeBS& nodeSubs = consCG->sccSubNodes(nodeId);
-    for(NodeBS::iterator sit = nodeSubs.begin(), esit = nodeSubs.end(); sit!=esit; ++sit)
-    {
-        NodeID subId = *sit;
-        consCG->setRep(subId,newRepId);
-    }
-    repSubs |= nodeSubs;
-    consCG->setSubs(newRepId,repSubs);
-    consCG->resetSubs(nodeId);
 }
 
 void Andersen::cluster(void) const
@@ -0,0 +1,601 @@
+//===- AndersenIncremental.cpp -- Incremental Andersen's analysis-------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenIncremental.cpp
+ *
+ * Incremental re-solving of Andersen's constraints (-incremental-ander).
+ *
+ * A run writes a state file holding a stable key per SVFIR node, the initial
+ * and final constraint graphs, the resolved indirect calls and the solution.
+ * The next run matches its nodes to the previous ones by key and diffs the
+ * initial constraints. Every previous node whose points-to set may depend on
+ * a removed constraint or on an unmatched node is marked affected, closing
+ * over the previous final constraint graph. The points-to sets of the
+ * remaining nodes are still valid lower bounds of the new solution, so they
+ * seed the solver and only the affected part is propagated again.
+ */
+
+#include "WPA/Andersen.h"
+#include "Util/Options.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+using namespace SVF;
+using namespace SVFUtil;
+using namespace std;
+
+namespace SVF
+{
+
+/*!
+ * Constraint-level snapshot of an Andersen run used by the next incremental run
+ */
+class AnderIncrementalState
+{
+public:
+    /// kind, src, dst and field offset of a constraint edge
+    typedef std::tuple<u32_t, NodeID, NodeID, APOffset> ConsSig;
+    /// gep object id, base object id and field offset
+    typedef std::tuple<NodeID, NodeID, APOffset> GepObjRecord;
+
+    Map<NodeID, std::string> keys;              ///< stable keys of SVFIR nodes (gep and dummy nodes excluded)
+    std::vector<GepObjRecord> gepObjs;          ///< field objects, identified through their base
+    NodeBS startFIObjs;                         ///< objects field-insensitive before solving
+    NodeBS collapsedObjs;                       ///< objects collapsed while solving
+    Map<NodeID, NodeID> reps;                   ///< merged nodes and their reps
+    std::vector<ConsSig> initialCons;           ///< constraints before solving
+    std::vector<ConsSig> finalCons;             ///< constraints after solving (between reps)
+    Map<NodeID, NodeBS> icalls;                 ///< function pointer -> nodes receiving params/returns
+    Map<NodeID, NodeBS> pts;                    ///< points-to sets of rep nodes
+
+    bool read(const std::string& filename);
+    void write(const std::string& filename) const;
+};
+
+}
+
+namespace
+{
+
+const char* IncrementalStateHeader = "SVFIncrementalAnder 1";
+
+AnderIncrementalState::ConsSig makeSig(const ConstraintEdge* edge)
+{
+    APOffset offset = 0;
+    if (const NormalGepCGEdge* gep = SVFUtil::dyn_cast<NormalGepCGEdge>(edge))
+        offset = gep->getConstantFieldIdx();
+    return std::make_tuple(edge->getEdgeKind(), edge->getSrcID(), edge->getDstID(), offset);
+}
+
+/*!
+ * A key is made of the node kind, the enclosing function and the value name,
+ * plus the occurrence number among nodes sharing that prefix so that unnamed
+ * values stay distinct. Nodes are visited in ID order, which follows the
+ * order of the module, so the key of a node does not change as long as its
+ * function does not.
+ */
+void computeStableKeys(SVFIR* pag, Map<NodeID, std::string>& keys)
+{
+    Map<std::string, u32_t> occurrences;
+    for (SVFIR::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        NodeID id = it->first;
+        const SVFVar* var = it->second;
+        if (SymbolTableInfo::isBlkPtr(id) || SymbolTableInfo::isNullPtr(id)
+                || SymbolTableInfo::isBlkObjOrConstantObj(id))
+        {
+            keys[id] = "special " + std::to_string(id);
+            continue;
+        }
+        if (SVFUtil::isa<GepObjVar, DummyValVar, DummyObjVar>(var))
+            continue;
+
+        std::string prefix = std::to_string(var->getNodeKind()) + " ";
+        if (const SVFFunction* fun = var->getFunction())
+            prefix += fun->getName();
+        prefix += " ";
+        if (var->hasValue())
+            prefix += var->getValueName();
+        std::replace(prefix.begin(), prefix.end(), '\n', ' ');
+        keys[id] = prefix + " #" + std::to_string(occurrences[prefix]++);
+    }
+}
+
+void writeNodeBS(std::ofstream& f, const NodeBS& bs)
+{
+    for (NodeID n : bs)
+        f << " " << n;
+}
+
+void readNodeBS(std::istringstream& ss, NodeBS& bs)
+{
+    NodeID n;
+    while (ss >> n)
+        bs.set(n);
+}
+
+}
+
+/*!
+ * Write the state as sections of one record per line
+ */
+void AnderIncrementalState::write(const std::string& filename) const
+{
+    outs() << "Storing incremental Andersen state to '" << filename << "'...";
+    std::ofstream f(filename.c_str());
+    if (!f.good())
+    {
+        outs() << "  error opening file for writing!\n";
+        return;
+    }
+
+    f << IncrementalStateHeader << "\n";
+    f << "[keys]\n";
+    for (const auto& it : keys)
+        f << it.first << " " << it.second << "\n";
+    f << "[gepobjs]\n";
+    for (const GepObjRecord& gep : gepObjs)
+        f << std::get<0>(gep) << " " << std::get<1>(gep) << " " << std::get<2>(gep) << "\n";
+    f << "[startfi]\n";
+    writeNodeBS(f, startFIObjs);
+    f << "\n[collapsed]\n";
+    writeNodeBS(f, collapsedObjs);
+    f << "\n[reps]\n";
+    for (const auto& it : reps)
+        f << it.first << " " << it.second << "\n";
+    f << "[initial]\n";
+    for (const ConsSig& sig : initialCons)
+        f << std::get<0>(sig) << " " << std::get<1>(sig) << " " << std::get<2>(sig) << " " << std::get<3>(sig) << "\n";
+    f << "[final]\n";
+    for (const ConsSig& sig : finalCons)
+        f << std::get<0>(sig) << " " << std::get<1>(sig) << " " << std::get<2>(sig) << " " << std::get<3>(sig) << "\n";
+    f << "[icalls]\n";
+    for (const auto& it : icalls)
+    {
+        f << it.first;
+        writeNodeBS(f, it.second);
+        f << "\n";
+    }
+    f << "[pts]\n";
+    for (const auto& it : pts)
+    {
+        f << it.first;
+        writeNodeBS(f, it.second);
+        f << "\n";
+    }
+    f << "[end]\n";
+
+    f.close();
+    if (f.good())
+        outs() << "\n";
+    else
+        outs() << "  error writing file!\n";
+}
+
+/*!
+ * Read a state written by write(). Returns false if the file is missing or
+ * not a complete state file, in which case nothing can be reused.
+ */
+bool AnderIncrementalState::read(const std::string& filename)
+{
+    std::ifstream f(filename.c_str());
+    if (!f.is_open())
+        return false;
+
+    std::string line;
+    if (!std::getline(f, line) || line != IncrementalStateHeader)
+        return false;
+
+    std::string section;
+    bool complete = false;
+    while (std::getline(f, line))
+    {
+        if (!line.empty() && line[0] == '[')
+        {
+            section = line;
+            if (section == "[end]")
+            {
+                complete = true;
+                break;
+            }
+            continue;
+        }
+        if (line.empty())
+            continue;
+
+        std::istringstream ss(line);
+        if (section == "[keys]")
+        {
+            size_t space = line.find(' ');
+            if (space == std::string::npos)
+                return false;
+            keys[std::stoul(line.substr(0, space))] = line.substr(space + 1);
+        }
+        else if (section == "[gepobjs]")
+        {
+            NodeID id, base;
+            APOffset offset;
+            ss >> id >> base >> offset;
+            gepObjs.push_back(std::make_tuple(id, base, offset));
+        }
+        else if (section == "[startfi]")
+            readNodeBS(ss, startFIObjs);
+        else if (section == "[collapsed]")
+            readNodeBS(ss, collapsedObjs);
+        else if (section == "[reps]")
+        {
+            NodeID sub, rep;
+            ss >> sub >> rep;
+            reps[sub] = rep;
+        }
+        else if (section == "[initial]" || section == "[final]")
+        {
+            u32_t kind;
+            NodeID src, dst;
+            APOffset offset;
+            ss >> kind >> src >> dst >> offset;
+            std::vector<ConsSig>& sigs = (section == "[initial]") ? initialCons : finalCons;
+            sigs.push_back(std::make_tuple(kind, src, dst, offset));
+        }
+        else if (section == "[icalls]" || section == "[pts]")
+        {
+            NodeID id;
+            ss >> id;
+            NodeBS& bs = (section == "[icalls]") ? icalls[id] : pts[id];
+            readNodeBS(ss, bs);
+        }
+    }
+    return complete;
+}
+
+/*!
+ * Solve constraints, reusing the solution of the run which wrote the state
+ * file for the part of the program that has not changed since
+ */
+void Andersen::solveIncrementally(const std::string& filename)
+{
+    initialize();
+
+    AnderIncrementalState cur;
+    recordConstraints(cur, true);
+
+    AnderIncrementalState prev;
+    if (prev.read(filename))
+        seedFromPreviousSolution(prev, cur);
+    else
+        outs() << "No incremental Andersen state in '" << filename << "', solving from scratch\n";
+
+    solveConstraints();
+
+    recordSolution(cur);
+    cur.write(filename);
+
+    const std::string& ptsFile = Options::WriteAnder();
+    if (!ptsFile.empty())
+    {
+        if (Options::BinaryAnder())
+            writeToBinaryFile(ptsFile);
+        else
+        {
+            writeObjVarToFile(ptsFile);
+            writeToFile(ptsFile);
+        }
+    }
+
+    finalize();
+}
+
+/*!
+ * Record the constraint edges of the current graph, plus the node keys and the
+ * field-insensitive objects when recording the initial graph
+ */
+void Andersen::recordConstraints(AnderIncrementalState& state, bool initial)
+{
+    std::vector<AnderIncrementalState::ConsSig>& sigs = initial ? state.initialCons : state.finalCons;
+    for (const ConstraintEdge* edge : consCG->getAddrCGEdges())
+        sigs.push_back(makeSig(edge));
+    for (const ConstraintEdge* edge : consCG->getDirectCGEdges())
+        sigs.push_back(makeSig(edge));
+    for (const ConstraintEdge* edge : consCG->getLoadCGEdges())
+        sigs.push_back(makeSig(edge));
+    for (const ConstraintEdge* edge : consCG->getStoreCGEdges())
+        sigs.push_back(makeSig(edge));
+
+    if (!initial)
+        return;
+
+    computeStableKeys(pag, state.keys);
+    for (SVFIR::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        if (SVFUtil::isa<ObjVar>(it->second) && !SVFUtil::isa<GepObjVar>(it->second)
+                && isFieldInsensitive(it->first))
+            state.startFIObjs.set(it->first);
+    }
+}
+
+/*!
+ * Record the solution and everything the next run needs to decide which part
+ * of it is still valid
+ */
+void Andersen::recordSolution(AnderIncrementalState& state)
+{
+    for (const auto& it : pag->getGepObjNodeMap())
+        state.gepObjs.push_back(std::make_tuple(it.second, it.first.first, it.first.second));
+
+    recordConstraints(state, false);
+
+    for (SVFIR::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        NodeID id = it->first;
+        NodeID rep = sccRepNode(id);
+        if (rep != id)
+        {
+            state.reps[id] = rep;
+            continue;
+        }
+        if (SVFUtil::isa<ObjVar>(it->second) && !SVFUtil::isa<GepObjVar>(it->second)
+                && isFieldInsensitive(id) && !state.startFIObjs.test(id))
+            state.collapsedObjs.set(id);
+
+        const PointsTo& pts = getPts(id);
+        if (pts.empty())
+            continue;
+        NodeBS& bs = state.pts[id];
+        for (NodeID o : pts)
+            bs.set(o);
+    }
+
+    /// A function pointer determines which formal parameters and returns
+    /// its callsite is connected to
+    for (const auto& it : getIndCallMap())
+    {
+        const CallICFGNode* cs = it.first;
+        CallSiteToFunPtrMap::const_iterator fit = getIndirectCallsites().find(cs);
+        if (fit == getIndirectCallsites().end())
+            continue;
+        NodeBS& dsts = state.icalls[sccRepNode(fit->second)];
+        const RetICFGNode* retNode = cs->getRetICFGNode();
+        if (pag->callsiteHasRet(retNode))
+            dsts.set(sccRepNode(pag->getCallSiteRet(retNode)->getId()));
+        for (const SVFFunction* callee : it.second)
+        {
+            if (pag->hasFunArgsList(callee))
+            {
+                for (const SVFVar* arg : pag->getFunArgsList(callee))
+                    dsts.set(sccRepNode(arg->getId()));
+            }
+            if (callee->isVarArg())
+                dsts.set(sccRepNode(pag->getVarargNode(callee)));
+        }
+    }
+}
+
+/*!
+ * Map the previous nodes onto the current ones, compute the previous nodes
+ * affected by the changes and seed the unaffected ones with their previous
+ * points-to sets
+ */
+void Andersen::seedFromPreviousSolution(const AnderIncrementalState& prev, const AnderIncrementalState& cur)
+{
+    typedef AnderIncrementalState::ConsSig ConsSig;
+
+    /// Match nodes by key; an object whose initial field-sensitivity differs is a different object
+    Map<std::string, NodeID> keyToNode;
+    for (const auto& it : cur.keys)
+        keyToNode[it.second] = it.first;
+    Map<NodeID, NodeID> oldToNew;
+    for (const auto& it : prev.keys)
+    {
+        auto nit = keyToNode.find(it.second);
+        if (nit == keyToNode.end())
+            continue;
+        if (prev.startFIObjs.test(it.first) != cur.startFIObjs.test(nit->second))
+            continue;
+        oldToNew[it.first] = nit->second;
+    }
+    /// Field objects are mapped through their bases and only created on demand
+    Map<NodeID, std::pair<NodeID, APOffset>> oldGepObjs;
+    for (const AnderIncrementalState::GepObjRecord& gep : prev.gepObjs)
+    {
+        auto bit = oldToNew.find(std::get<1>(gep));
+        if (bit != oldToNew.end())
+            oldGepObjs[std::get<0>(gep)] = std::make_pair(bit->second, std::get<2>(gep));
+    }
+    auto isMapped = [&](NodeID old)
+    {
+        return oldToNew.count(old) || oldGepObjs.count(old);
+    };
+    auto mapNode = [&](NodeID old)
+    {
+        auto it = oldToNew.find(old);
+        if (it != oldToNew.end())
+            return it->second;
+        const std::pair<NodeID, APOffset>& gep = oldGepObjs.at(old);
+        NodeID id = consCG->getGepObjVar(gep.first, gep.second);
+        oldToNew[old] = id;
+        return id;
+    };
+    auto oldRep = [&](NodeID old)
+    {
+        auto it = prev.reps.find(old);
+        return it == prev.reps.end() ? old : it->second;
+    };
+    auto oldPts = [&](NodeID oldrep) -> const NodeBS*
+    {
+        auto it = prev.pts.find(oldrep);
+        return it == prev.pts.end() ? nullptr : &it->second;
+    };
+
+    /// Previous final constraint graph, restricted to what affectedness flows along
+    Map<NodeID, NodeBS> succs;          ///< copy/gep/load src -> dst
+    NodeBS storeDsts;                   ///< pointers stored through
+    for (const ConsSig& sig : prev.finalCons)
+    {
+        u32_t kind = std::get<0>(sig);
+        if (kind == ConstraintEdge::Addr)
+            continue;
+        if (kind == ConstraintEdge::Store)
+            storeDsts.set(std::get<2>(sig));
+        else
+            succs[std::get<1>(sig)].set(std::get<2>(sig));
+    }
+
+    NodeBS affected;
+    FIFOWorkList<NodeID> worklist;
+    auto markAffected = [&](NodeID old)
+    {
+        NodeID rep = oldRep(old);
+        if (affected.test_and_set(rep))
+            worklist.push(rep);
+    };
+    auto markPointees = [&](NodeID old)
+    {
+        if (const NodeBS* pts = oldPts(oldRep(old)))
+            for (NodeID o : *pts)
+                markAffected(o);
+    };
+
+    /// Seeds (1): unmatched nodes, objects collapsed by the previous run and
+    /// every node pointing to either of them
+    NodeBS invalidObjs = prev.collapsedObjs;
+    for (const auto& it : prev.keys)
+        if (!isMapped(it.first))
+            markAffected(it.first);
+    for (const auto& it : prev.reps)
+        if (!isMapped(it.first))
+            markAffected(it.first);
+    for (const AnderIncrementalState::GepObjRecord& gep : prev.gepObjs)
+        if (prev.collapsedObjs.test(std::get<1>(gep)) || !isMapped(std::get<0>(gep)))
+            invalidObjs.set(std::get<0>(gep));
+    for (NodeID o : invalidObjs)
+        markAffected(o);
+    for (const auto& it : prev.pts)
+    {
+        if (!isMapped(it.first))
+            markAffected(it.first);
+        for (NodeID o : it.second)
+        {
+            if (!isMapped(o) || invalidObjs.test(o))
+            {
+                markAffected(it.first);
+                break;
+            }
+        }
+    }
+
+    /// Seeds (2): targets of removed constraints
+    OrderedSet<ConsSig> curInitial(cur.initialCons.begin(), cur.initialCons.end());
+    OrderedSet<ConsSig> keptInitial;
+    for (const ConsSig& sig : prev.initialCons)
+    {
+        NodeID src = std::get<1>(sig), dst = std::get<2>(sig);
+        if (isMapped(src) && isMapped(dst))
+        {
+            ConsSig mapped = std::make_tuple(std::get<0>(sig), mapNode(src), mapNode(dst), std::get<3>(sig));
+            if (curInitial.count(mapped))
+            {
+                keptInitial.insert(mapped);
+                continue;
+            }
+        }
+        markAffected(dst);
+        if (std::get<0>(sig) == ConstraintEdge::Store)
+            markPointees(dst);
+    }
+
+    /// Close over the previous final graph: copy, gep and load edges (including
+    /// those derived from loads, stores and indirect calls) carry affectedness to
+    /// their dst, an affected pointer stored through affects its pointees and an
+    /// affected function pointer affects the parameters it was connected to
+    while (!worklist.empty())
+    {
+        NodeID rep = worklist.pop();
+        auto sit = succs.find(rep);
+        if (sit != succs.end())
+            for (NodeID dst : sit->second)
+                markAffected(dst);
+        if (storeDsts.test(rep))
+            markPointees(rep);
+        auto iit = prev.icalls.find(rep);
+        if (iit != prev.icalls.end())
+            for (NodeID dst : iit->second)
+                markAffected(dst);
+    }
+
+    /// Seed the unaffected nodes with their previous points-to sets
+    NodeBS seeded;
+    Map<NodeID, PointsTo> translated;
+    std::vector<NodeID> oldNodes;
+    for (const auto& it : prev.keys)
+        oldNodes.push_back(it.first);
+    for (const AnderIncrementalState::GepObjRecord& gep : prev.gepObjs)
+        oldNodes.push_back(std::get<0>(gep));
+    for (NodeID old : oldNodes)
+    {
+        NodeID rep = oldRep(old);
+        const NodeBS* pts = oldPts(rep);
+        if (affected.test(rep) || pts == nullptr || !isMapped(old))
+            continue;
+        auto tit = translated.find(rep);
+        if (tit == translated.end())
+        {
+            PointsTo& target = translated[rep];
+            for (NodeID o : *pts)
+                target.set(mapNode(o));
+            tit = translated.find(rep);
+        }
+        NodeID id = mapNode(old);
+        getPTDataTy()->unionPts(id, tit->second);
+        seeded.set(id);
+    }
+    for (NodeID id : seeded)
+        computeDiffPts(id);
+
+    /// Sources of edges into re-solved nodes and of added constraints propagate
+    /// again; loads and stores are re-processed to rebuild their derived copy edges
+    for (const ConstraintEdge* edge : consCG->getDirectCGEdges())
+    {
+        if (seeded.test(edge->getSrcID()) && !seeded.test(edge->getDstID()))
+        {
+            clearPropaPts(edge->getSrcID());
+            pushIntoWorklist(edge->getSrcID());
+        }
+    }
+    for (const ConsSig& sig : cur.initialCons)
+    {
+        if (keptInitial.count(sig))
+            continue;
+        clearPropaPts(std::get<1>(sig));
+        pushIntoWorklist(std::get<1>(sig));
+    }
+    for (const ConstraintEdge* edge : consCG->getLoadCGEdges())
+        pushIntoWorklist(edge->getSrcID());
+    for (const ConstraintEdge* edge : consCG->getStoreCGEdges())
+        pushIntoWorklist(edge->getDstID());
+
+    u32_t numOfOldNodes = oldNodes.size();
+    outs() << "Incremental Andersen: reused the points-to sets of " << seeded.count()
+           << " nodes, " << affected.count() << " of " << numOfOldNodes << " previous nodes affected\n";
+}
@@ -68,7 +68,7 @@ void AndersenStat::collectCycleInfo(ConstraintGraph* consCG)
     {
         // sub nodes have been removed from the constraint graph, only rep nodes are left.
         NodeID repNode = consCG->sccRepNode(it->first);
-        NodeBS& subNodes = consCG->sccSubNodes(repNode);
+        NodeBS subNodes = consCG->sccSubNodes(repNode);
         NodeBS clone = subNodes;
         for (NodeBS::iterator it = subNodes.begin(), eit = subNodes.end(); it != eit; ++it)
         {
@@ -30,12 +30,47 @@
 #include "WPA/Andersen.h"
 #include "MemoryModel/PointsTo.h"
 
+#include <atomic>
+#include <thread>
+
 using namespace SVF;
 using namespace SVFUtil;
 using namespace std;
 
 AndersenWaveDiff* AndersenWaveDiff::diffWave = nullptr;
 
+/// Below this many items per thread, spawning workers costs more than it saves.
+static const size_t MinItemsPerThread = 64;
+
+/*!
+ * Run body(i) for every i in [0, n) on at most Options::AnderThreads() threads.
+ * body must only write to data owned by index i.
+ */
+template <typename Body>
+static void parallelFor(size_t n, Body body)
+{
+    size_t numThreads = std::min<size_t>(Options::AnderThreads(), n / MinItemsPerThread);
+    if (numThreads <= 1)
+    {
+        for (size_t i = 0; i < n; ++i)
+            body(i);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    auto worker = [&next, &body, n]()
+    {
+        for (size_t i = next++; i < n; i = next++)
+            body(i);
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < numThreads; ++t)
+        workers.push_back(std::thread(worker));
+    for (std::thread& w : workers)
+        w.join();
+}
+
 /*!
  * Initialize
  */
@@ -50,6 +85,12 @@ void AndersenWaveDiff::initialize()
  */
 void AndersenWaveDiff::solveWorklist()
 {
+    if (Options::AnderThreads() > 1)
+    {
+        solveWorklistInParallel();
+        return;
+    }
+
     // Initialize the nodeStack via a whole SCC detection
     // Nodes in nodeStack are in topological order by default.
     NodeStack& nodeStack = SCCDetect();
@@ -152,3 +193,183 @@ bool AndersenWaveDiff::handleStore(NodeID nodeId, const ConstraintEdge* edge)
     }
     return changed;
 }
+
+/*!
+ * Solve worklist with the wave propagation spread over Options::AnderThreads() threads.
+ *
+ * SCC detection and merging stay serial. The topological order is then cut into levels
+ * such that no direct edge connects two nodes of the same level. Within a level, the
+ * points-to sets flowing into each copy destination are unioned concurrently, while
+ * updates to the shared points-to data and the constraint graph are applied serially
+ * in a fixed order, so the result does not depend on the number of threads.
+ */
+void AndersenWaveDiff::solveWorklistInParallel()
+{
+    NodeStack& nodeStack = SCCDetect();
+
+    // A node is placed one level after its deepest direct predecessor.
+    std::vector<std::vector<NodeID>> levels;
+    Map<NodeID, u32_t> nodeToLevel;
+    while (!nodeStack.empty())
+    {
+        NodeID nodeId = nodeStack.top();
+        nodeStack.pop();
+
+        u32_t level = nodeToLevel[nodeId];
+        if (levels.size() <= level)
+            levels.resize(level + 1);
+        levels[level].push_back(nodeId);
+
+        ConstraintNode* node = consCG->getConstraintNode(nodeId);
+        for (ConstraintEdge* edge : node->getDirectOutEdges())
+        {
+            NodeID dst = sccRepNode(edge->getDstID());
+            if (dst == nodeId)
+                continue;
+            u32_t& dstLevel = nodeToLevel[dst];
+            dstLevel = std::max(dstLevel, level + 1);
+        }
+    }
+
+    for (const std::vector<NodeID>& level : levels)
+        processLevel(level);
+
+    std::vector<NodeID> nodes;
+    while (!isWorklistEmpty())
+        nodes.push_back(popFromWorklist());
+    postProcessNodes(nodes);
+}
+
+/*!
+ * Propagate the diff points-to sets of all nodes in one level along copy and gep edges
+ */
+void AndersenWaveDiff::processLevel(const std::vector<NodeID>& level)
+{
+    // Collapsing PWCs changes the graph, so it is done before the level is propagated.
+    for (NodeID nodeId : level)
+        collapsePWCNode(nodeId);
+    collapseFields();
+
+    double propStart = stat->getClk();
+
+    // Compute diff pts of the rep nodes and group their copy edges by destination,
+    // in the order of first appearance.
+    std::vector<NodeID> srcNodes;
+    std::vector<NodeID> dstNodes;
+    std::vector<std::vector<NodeID>> dstToSrcs;
+    Map<NodeID, u32_t> dstToIdx;
+    for (NodeID nodeId : level)
+    {
+        if (sccRepNode(nodeId) != nodeId)
+            continue;
+
+        computeDiffPts(nodeId);
+        if (getDiffPts(nodeId).empty())
+            continue;
+
+        srcNodes.push_back(nodeId);
+        ConstraintNode* node = consCG->getConstraintNode(nodeId);
+        for (ConstraintEdge* edge : node->getCopyOutEdges())
+        {
+            numOfProcessedCopy++;
+            NodeID dst = sccRepNode(edge->getDstID());
+            if (dst == nodeId)
+                continue;
+            Map<NodeID, u32_t>::const_iterator it = dstToIdx.find(dst);
+            if (it == dstToIdx.end())
+            {
+                it = dstToIdx.emplace(dst, dstNodes.size()).first;
+                dstNodes.push_back(dst);
+                dstToSrcs.emplace_back();
+            }
+            dstToSrcs[it->second].push_back(nodeId);
+        }
+    }
+
+    // Only diff pts computed above are read here, the points-to data is not modified.
+    std::vector<PointsTo> incomingPts(dstNodes.size());
+    parallelFor(dstNodes.size(), [this, &dstToSrcs, &incomingPts](size_t i)
+    {
+        for (NodeID src : dstToSrcs[i])
+            incomingPts[i] |= getDiffPts(src);
+    });
+
+    for (size_t i = 0; i < dstNodes.size(); ++i)
+    {
+        if (unionPts(dstNodes[i], incomingPts[i]))
+            pushIntoWorklist(dstNodes[i]);
+    }
+
+    // Gep edges may create new field objects, so they are handled serially.
+    for (NodeID nodeId : srcNodes)
+    {
+        ConstraintNode* node = consCG->getConstraintNode(nodeId);
+        for (ConstraintEdge* edge : node->getGepOutEdges())
+        {
+            if (GepCGEdge* gepEdge = SVFUtil::dyn_cast<GepCGEdge>(edge))
+                processGep(nodeId, gepEdge);
+        }
+    }
+
+    double propEnd = stat->getClk();
+    timeOfProcessCopyGep += (propEnd - propStart) / TIMEINTERVAL;
+}
+
+/*!
+ * Post process nodes: collect the copy edges introduced by loads and stores concurrently,
+ * then add them to the constraint graph in the same order as postProcessNode would.
+ */
+void AndersenWaveDiff::postProcessNodes(const std::vector<NodeID>& nodes)
+{
+    double insertStart = stat->getClk();
+
+    // Make sure every pts entry exists before it is read concurrently.
+    for (NodeID nodeId : nodes)
+        getPts(nodeId);
+
+    std::vector<std::vector<NodePair>> newCopyEdges(nodes.size());
+    std::vector<u32_t> numOfLoads(nodes.size(), 0);
+    parallelFor(nodes.size(), [this, &nodes, &newCopyEdges, &numOfLoads](size_t i)
+    {
+        NodeID nodeId = nodes[i];
+        const ConstraintNode* node = consCG->getConstraintNode(nodeId);
+        const PointsTo& pts = getPts(nodeId);
+        std::vector<NodePair>& edges = newCopyEdges[i];
+
+        // Same filtering as processLoad and processStore.
+        for (ConstraintNode::const_iterator it = node->outgoingLoadsBegin(), eit = node->outgoingLoadsEnd();
+                it != eit; ++it)
+        {
+            for (NodeID ptd : pts)
+            {
+                if (!pag->isConstantObj(ptd) && !isNonPointerObj(ptd))
+                    edges.push_back(std::make_pair(ptd, (*it)->getDstID()));
+            }
+        }
+        numOfLoads[i] = edges.size();
+
+        for (ConstraintNode::const_iterator it = node->incomingStoresBegin(), eit = node->incomingStoresEnd();
+                it != eit; ++it)
+        {
+            for (NodeID ptd : pts)
+            {
+                if (!pag->isConstantObj(ptd) && !isNonPointerObj(ptd))
+                    edges.push_back(std::make_pair((*it)->getSrcID(), ptd));
+            }
+        }
+    });
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        numOfProcessedLoad += numOfLoads[i];
+        numOfProcessedStore += newCopyEdges[i].size() - numOfLoads[i];
+        for (const NodePair& edge : newCopyEdges[i])
+        {
+            if (addCopyEdge(edge.first, edge.second))
+                reanalyze = true;
+        }
+    }
+
+    double insertEnd = stat->getClk();
+    timeOfProcessLoadStore += (insertEnd - insertStart) / TIMEINTERVAL;
+}
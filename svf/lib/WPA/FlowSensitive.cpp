@@ -28,6 +28,7 @@
  */
 
 #include "Util/Options.h"
+#include "Util/PhaseStat.h"
 #include "SVFIR/SVFModule.h"
 #include "WPA/WPAStat.h"
 #include "WPA/FlowSensitive.h"
@@ -72,6 +73,7 @@ void FlowSensitive::initialize()
     svfg = memSSA.buildPTROnlySVFG(ander);
 
     setGraph(svfg);
+    setSCCThreads(Options::SCCThreads());
     //AndersenWaveDiff::releaseAndersenWaveDiff();
 }
 void FlowSensitive::solveConstraints()
@@ -127,6 +129,7 @@ void FlowSensitive::solveAndwritePtsToFile(const std::string& filename)
  */
 void FlowSensitive::analyze()
 {
+    PhaseStat::Scope phase(PTAName());
     if(!Options::ReadAnder().empty())
     {
         readPtsFromFile(Options::ReadAnder());
@@ -225,6 +228,7 @@ void FlowSensitive::processNode(NodeID nodeId)
         propagate(&node);
 
     clearAllDFOutVarFlag(node);
+    collectPtsGarbageIfNeeded();
 }
 
 /*!
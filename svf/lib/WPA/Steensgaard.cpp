@@ -79,24 +79,19 @@ void Steensgaard::solveWorklist()
     }
 }
 
-void Steensgaard::setEC(NodeID node, NodeID rep)
-{
-    rep = getEC(rep);
-    Set<NodeID>& subNodes = getSubNodes(node);
-    for (NodeID sub : subNodes)
-    {
-        nodeToECMap[sub] = rep;
-        addSubNode(rep, sub);
-    }
-    subNodes.clear();
-}
-
-/// merge node into equiv class and merge node's pts into ec's pts
+/// merge the equiv classes of node and ec, both of which then have the union of their pts
 void Steensgaard::ecUnion(NodeID node, NodeID ec)
 {
-    if (unionPts(ec, node))
+    NodeID nodeEC = getEC(node);
+    NodeID ecEC = getEC(ec);
+    if (nodeEC == ecEC)
+        return;
+
+    if (getPTDataTy()->unionPts(ecEC, nodeEC))
         pushIntoWorklist(ec);
-    setEC(node, ec);
+    if (getPTDataTy()->unionPts(nodeEC, ecEC))
+        pushIntoWorklist(node);
+    ecs.unite(nodeEC, ecEC);
 }
 
 /*!
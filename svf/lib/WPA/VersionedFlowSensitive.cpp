@@ -15,6 +15,7 @@
 #include <queue>
 #include <thread>
 #include <mutex>
+#include <deque>
 
 using namespace SVF;
 
@@ -545,6 +546,12 @@ void VersionedFlowSensitive::removeAllIndirectSVFGEdges(void)
 
 void VersionedFlowSensitive::propagateVersion(NodeID o, Version v)
 {
+    if (Options::VFSThreads() > 1)
+    {
+        pendingVersions[o].insert(v);
+        return;
+    }
+
     double start = stat->getClk();
 
     const std::vector<Version> &reliantVersions = getReliantVersions(o, v);
@@ -559,6 +566,13 @@ void VersionedFlowSensitive::propagateVersion(NodeID o, Version v)
 
 void VersionedFlowSensitive::propagateVersion(const NodeID o, const Version v, const Version vp, bool time/*=true*/)
 {
+    if (Options::VFSThreads() > 1)
+    {
+        // Propagating v to every reliant version subsumes propagating it to vp.
+        pendingVersions[o].insert(v);
+        return;
+    }
+
     double start = time ? stat->getClk() : 0.0;
 
     const VersionedVar srcVar = atKey(o, v);
@@ -600,6 +614,180 @@ void VersionedFlowSensitive::processNode(NodeID n)
     {
         propagate(&sn);
     }
+
+    collectPtsGarbageIfNeeded();
+}
+
+void VersionedFlowSensitive::solveWorklist()
+{
+    if (Options::VFSThreads() <= 1)
+    {
+        FlowSensitive::solveWorklist();
+        return;
+    }
+
+    while (!isWorklistEmpty() || !pendingVersions.empty())
+    {
+        while (!isWorklistEmpty())
+            processNode(popFromWorklist());
+
+        propagateVersionsInParallel();
+    }
+}
+
+void VersionedFlowSensitive::propagateVersionsInParallel(void)
+{
+    if (pendingVersions.empty()) return;
+
+    double start = stat->getClk();
+
+    /// The versions of an object reachable from its pending versions, which is what a worker may
+    /// read or update. Points-to sets are looked up beforehand as getPts may insert into vPtD.
+    struct ObjectTask
+    {
+        NodeID o;
+        std::vector<Version> versions;
+        Map<Version, u32_t> index;
+        std::vector<u32_t> sources;
+        std::vector<const PointsTo *> base;
+        std::vector<PointsTo> updated;
+        std::vector<bool> isUpdated;
+    };
+
+    std::vector<ObjectTask> tasks;
+    tasks.reserve(pendingVersions.size());
+    for (const Map<NodeID, Set<Version>>::value_type &ovs : pendingVersions)
+    {
+        const NodeID o = ovs.first;
+        VersionRelianceMap::const_iterator relianceIt = versionReliance.find(o);
+        if (relianceIt == versionReliance.end()) continue;
+        const Map<Version, std::vector<Version>> &reliance = relianceIt->second;
+
+        tasks.emplace_back();
+        ObjectTask &task = tasks.back();
+        task.o = o;
+        auto addVersion = [&task](Version v)
+        {
+            if (task.index.emplace(v, task.versions.size()).second)
+                task.versions.push_back(v);
+        };
+
+        for (Version v : ovs.second) addVersion(v);
+        for (u32_t i = 0; i < task.versions.size(); ++i) task.sources.push_back(i);
+        for (u32_t i = 0; i < task.versions.size(); ++i)
+        {
+            Map<Version, std::vector<Version>>::const_iterator rIt = reliance.find(task.versions[i]);
+            if (rIt == reliance.end()) continue;
+            for (Version r : rIt->second) addVersion(r);
+        }
+
+        if (task.versions.size() == task.sources.size())
+        {
+            // Nothing relies on the pending versions.
+            tasks.pop_back();
+            continue;
+        }
+
+        for (Version v : task.versions) vPtD->getPts(atKey(o, v));
+        for (Version v : task.versions) task.base.push_back(&vPtD->getPts(atKey(o, v)));
+    }
+
+    pendingVersions.clear();
+
+    auto propagateObject = [this](ObjectTask &task)
+    {
+        const Map<Version, std::vector<Version>> &reliance = versionReliance.find(task.o)->second;
+        task.updated.resize(task.versions.size());
+        task.isUpdated.resize(task.versions.size(), false);
+
+        FIFOWorkList<u32_t> worklist;
+        for (u32_t i : task.sources) worklist.push(i);
+        while (!worklist.empty())
+        {
+            const u32_t i = worklist.pop();
+            Map<Version, std::vector<Version>>::const_iterator rIt = reliance.find(task.versions[i]);
+            if (rIt == reliance.end()) continue;
+
+            const PointsTo &pts = task.isUpdated[i] ? task.updated[i] : *task.base[i];
+            for (Version r : rIt->second)
+            {
+                const u32_t j = task.index.find(r)->second;
+                if (i == j) continue;
+                if (task.isUpdated[j])
+                {
+                    if (task.updated[j] |= pts) worklist.push(j);
+                }
+                else if (!task.base[j]->contains(pts))
+                {
+                    task.updated[j] = *task.base[j];
+                    task.updated[j] |= pts;
+                    task.isUpdated[j] = true;
+                    worklist.push(j);
+                }
+            }
+        }
+    };
+
+    // Each worker starts with a contiguous share of the objects, taking tasks from the back
+    // of its own queue and, once empty, stealing from the front of the others'.
+    const size_t numThreads = std::min<size_t>(Options::VFSThreads(), tasks.size());
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+    std::vector<TaskQueue> queues(numThreads);
+    for (size_t t = 0; t < tasks.size(); ++t) queues[t * numThreads / tasks.size()].tasks.push_back(t);
+
+    auto worker = [&queues, &tasks, &propagateObject, numThreads](size_t self)
+    {
+        while (true)
+        {
+            bool found = false;
+            size_t t = 0;
+            for (size_t k = 0; k < numThreads && !found; ++k)
+            {
+                TaskQueue &queue = queues[(self + k) % numThreads];
+                std::lock_guard<std::mutex> guard(queue.mutex);
+                if (queue.tasks.empty()) continue;
+                if (k == 0)
+                {
+                    t = queue.tasks.back();
+                    queue.tasks.pop_back();
+                }
+                else
+                {
+                    t = queue.tasks.front();
+                    queue.tasks.pop_front();
+                }
+                found = true;
+            }
+
+            // No task is created while working, so empty queues mean we are done.
+            if (!found) return;
+            propagateObject(tasks[t]);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < numThreads; ++t) workers.push_back(std::thread(worker, t));
+    if (numThreads > 0) worker(0);
+    for (std::thread &w : workers) w.join();
+
+    for (ObjectTask &task : tasks)
+    {
+        for (u32_t i = 0; i < task.versions.size(); ++i)
+        {
+            if (!task.isUpdated[i]) continue;
+            const Version v = task.versions[i];
+            vPtD->unionPts(atKey(task.o, v), task.updated[i]);
+            // Notify nodes which rely on o:v that it changed.
+            for (NodeID s : getStmtReliance(task.o, v)) pushIntoWorklist(s);
+        }
+    }
+
+    double end = stat->getClk();
+    versionPropTime += (end - start) / TIMEINTERVAL;
 }
 
 void VersionedFlowSensitive::updateConnectedNodes(const SVFGEdgeSetTy& newEdges)
@@ -1111,6 +1299,7 @@ unsigned VersionedFlowSensitive::SCC::detectSCCs(VersionedFlowSensitive *vfs,
 
     std::vector<NodeData> nodeData(svfg->getTotalNodeNum(), { -1, -1, false});
     std::stack<const SVFGNode *> stack;
+    std::vector<Frame> dfs;
 
     int index = 0;
     int currentSCC = 0;
@@ -1119,7 +1308,7 @@ unsigned VersionedFlowSensitive::SCC::detectSCCs(VersionedFlowSensitive *vfs,
     {
         if (nodeData[v->getId()].index == -1)
         {
-            visit(vfs, object, partOf, footprint, nodeData, stack, index, currentSCC, v);
+            visit(vfs, object, partOf, footprint, nodeData, stack, dfs, index, currentSCC, v);
         }
     }
 
@@ -1135,64 +1324,94 @@ void VersionedFlowSensitive::SCC::visit(VersionedFlowSensitive *vfs,
                                         std::vector<const IndirectSVFGEdge *> &footprint,
                                         std::vector<NodeData> &nodeData,
                                         std::stack<const SVFGNode *> &stack,
+                                        std::vector<Frame> &dfs,
                                         int &index,
                                         int &currentSCC,
-                                        const SVFGNode *v)
+                                        const SVFGNode *root)
 {
-    const NodeID vId = v->getId();
-
-    nodeData[vId].index = index;
-    nodeData[vId].lowlink = index;
-    ++index;
+    // Tarjan's algorithm with its own stack of nodes being visited so that long
+    // chains of indirect edges do not overflow the call stack.
+    const SVFGNode *v = root;
+    do
+    {
+        const NodeID vId = v->getId();
+        if (nodeData[vId].index == -1)
+        {
+            nodeData[vId].index = index;
+            nodeData[vId].lowlink = index;
+            ++index;
 
-    stack.push(v);
-    nodeData[vId].onStack = true;
+            stack.push(v);
+            nodeData[vId].onStack = true;
+            dfs.push_back({ v, v->OutEdgeBegin() });
+        }
 
-    for (const SVFGEdge *e : v->getOutEdges())
-    {
-        const IndirectSVFGEdge *ie = SVFUtil::dyn_cast<IndirectSVFGEdge>(e);
-        if (!ie) continue;
+        Frame &frame = dfs.back();
+        const SVFGNode *next = nullptr;
+        for (; frame.edge != v->OutEdgeEnd(); ++frame.edge)
+        {
+            const IndirectSVFGEdge *ie = SVFUtil::dyn_cast<IndirectSVFGEdge>(*frame.edge);
+            if (!ie) continue;
 
-        const SVFGNode *w = ie->getDstNode();
-        const NodeID wId = w->getId();
+            const SVFGNode *w = ie->getDstNode();
+            const NodeID wId = w->getId();
 
-        // If object is not part of the edge, there is no edge from v to w.
-        if (!ie->getPointsTo().test(object)) continue;
+            // If object is not part of the edge, there is no edge from v to w.
+            if (!ie->getPointsTo().test(object)) continue;
 
-        // Even if we don't count edges to stores and deltas for SCCs' sake, they
-        // are relevant to the footprint as a propagation still occurs over such edges.
-        footprint.push_back(ie);
+            // Even if we don't count edges to stores and deltas for SCCs' sake, they
+            // are relevant to the footprint as a propagation still occurs over such edges.
+            footprint.push_back(ie);
 
-        // Ignore edges to delta nodes because they are prelabeled so cannot
-        // be part of the SCC v is in (already in nodesTodo from the prelabeled set).
-        // Similarly, store nodes.
-        if (vfs->delta(wId) || vfs->isStore(wId)) continue;
+            // Ignore edges to delta nodes because they are prelabeled so cannot
+            // be part of the SCC v is in (already in nodesTodo from the prelabeled set).
+            // Similarly, store nodes.
+            if (vfs->delta(wId) || vfs->isStore(wId)) continue;
 
-        if (nodeData[wId].index == -1)
-        {
-            visit(vfs, object, partOf, footprint, nodeData, stack, index, currentSCC, w);
-            nodeData[vId].lowlink = std::min(nodeData[vId].lowlink, nodeData[wId].lowlink);
+            if (nodeData[wId].index == -1)
+            {
+                // Visit w first, its lowlink is taken once it is finished.
+                next = w;
+                ++frame.edge;
+                break;
+            }
+            else if (nodeData[wId].onStack)
+            {
+                nodeData[vId].lowlink = std::min(nodeData[vId].lowlink, nodeData[wId].index);
+            }
         }
-        else if (nodeData[wId].onStack)
+
+        if (next != nullptr)
         {
-            nodeData[vId].lowlink = std::min(nodeData[vId].lowlink, nodeData[wId].index);
+            v = next;
+            continue;
         }
-    }
 
-    if (nodeData[vId].lowlink == nodeData[vId].index)
-    {
-        const SVFGNode *w = nullptr;
-        do
+        // All of v's edges are handled.
+        dfs.pop_back();
+        if (nodeData[vId].lowlink == nodeData[vId].index)
         {
-            w = stack.top();
-            stack.pop();
-            const NodeID wId = w->getId();
-            nodeData[wId].onStack = false;
-            partOf[wId] = currentSCC;
+            const SVFGNode *w = nullptr;
+            do
+            {
+                w = stack.top();
+                stack.pop();
+                const NodeID wId = w->getId();
+                nodeData[wId].onStack = false;
+                partOf[wId] = currentSCC;
+            }
+            while (w != v);
+
+            // For the next SCC.
+            ++currentSCC;
         }
-        while (w != v);
 
-        // For the next SCC.
-        ++currentSCC;
+        if (dfs.empty()) break;
+
+        const SVFGNode *parent = dfs.back().node;
+        const NodeID parentId = parent->getId();
+        nodeData[parentId].lowlink = std::min(nodeData[parentId].lowlink, nodeData[vId].lowlink);
+        v = parent;
     }
+    while (true);
 }